@@ -0,0 +1,66 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <stltoys/function.h>
+
+namespace {
+	constexpr std::size_t rounds = 2'000'000;
+	constexpr std::size_t batch = 64;
+
+	auto add_one(std::uint64_t x) ->std::uint64_t {
+		return x + 1;
+	}
+
+	template<typename Fn>
+	auto time(const char* what, const char* name, Fn&& body) ->void {
+		std::uint64_t checksum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < rounds / batch; ++i) checksum += body(i);
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		std::printf("%-10s %-26s %8.2f ns/op  (checksum %llu)\n", what, name, elapsed.count() / rounds, static_cast<unsigned long long>(checksum));
+	}
+
+	template<typename Signature>
+	using inplace_function_64 = ccat::inplace_function<Signature, 64>;
+
+	template<template<typename> typename Function, typename Callable>
+	auto run(const char* name, Callable callable) ->void {
+		using function_type = Function<std::uint64_t(std::uint64_t)>;
+		std::vector<function_type> fns(batch);
+		std::vector<function_type> copies(batch);
+		time("construct", name, [&](std::size_t i) {
+			for (auto& fn : fns) fn = function_type(callable); // a registry replacing its callbacks
+			return fns[i % batch](i);
+		});
+		time("copy", name, [&](std::size_t i) {
+			for (std::size_t j = 0; j < batch; ++j) copies[j] = fns[j];
+			return copies[i % batch](i);
+		});
+		time("invoke", name, [&](std::size_t i) {
+			std::uint64_t sum = i;
+			for (auto& fn : fns) sum = fn(sum);
+			return sum;
+		});
+	}
+
+	template<template<typename> typename Function>
+	auto run_all(const char* library) ->void {
+		std::printf("%s\n", library);
+		std::uint64_t offset = 3;
+		std::array<std::uint64_t, 8> table{1, 2, 3, 4, 5, 6, 7, 8};
+		run<Function>("function pointer", &add_one);
+		run<Function>("capture-less lambda", [](std::uint64_t x) { return x + 1; });
+		run<Function>("one-pointer capture", [&offset](std::uint64_t x) { return x + offset; });
+		run<Function>("two-word capture", [&offset, scale = std::uint64_t{2}](std::uint64_t x) { return x * scale + offset; });
+		run<Function>("64-byte capture", [table](std::uint64_t x) { return x + table[x % 8]; });
+	}
+}
+
+auto main() ->int {
+	run_all<std::function>("std::function");
+	run_all<ccat::function>("ccat::function");
+	run_all<inplace_function_64>("ccat::inplace_function<64>");
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <stltoys/mpmc_queue.h>
+
+namespace {
+	constexpr std::size_t items = 4'000'000;
+	constexpr std::size_t capacity = 1024;
+
+	auto bench(std::size_t threads, bool try_only) ->void { // half of the threads produce and half consume; a single thread does both in turn
+		ccat::mpmc_queue<std::size_t> queue{capacity};
+		std::atomic<std::size_t> checksum{0};
+		auto push = [&](std::size_t i) {
+			if (!try_only) queue.push(i);
+			else while (!queue.try_push(i)) std::this_thread::yield();
+		};
+		auto pop = [&] {
+			if (!try_only) return queue.pop();
+			std::size_t value;
+			while (!queue.try_pop(value)) std::this_thread::yield();
+			return value;
+		};
+		auto start = std::chrono::steady_clock::now();
+		if (threads == 1) {
+			std::size_t sum = 0;
+			for (std::size_t i = 0; i < items; ++i) {
+				push(i);
+				sum += pop();
+			}
+			checksum = sum;
+		}
+		else {
+			auto pairs = threads / 2;
+			std::vector<std::thread> workers;
+			for (std::size_t p = 0; p < pairs; ++p) {
+				workers.emplace_back([&, p] {
+					for (std::size_t i = p; i < items; i += pairs) push(i);
+				});
+				workers.emplace_back([&, p] {
+					std::size_t sum = 0;
+					for (std::size_t i = p; i < items; i += pairs) sum += pop();
+					checksum += sum;
+				});
+			}
+			for (auto& worker : workers) worker.join();
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		auto ops = 2.0 * items / elapsed.count(); // every item is pushed once and popped once
+		std::printf("%-8s %2zu threads  %8.2f Mops/s  %8.2f Mops/s per thread  (checksum %zu)\n", try_only ? "try" : "blocking", threads, ops / 1e6, ops / 1e6 / threads, checksum.load());
+	}
+}
+
+auto main() ->int {
+	for (bool try_only : {false, true}) { // the try_ operations never sleep, so they show the cost of publishing alone
+		for (std::size_t threads = 1; threads <= 64; threads *= 2) {
+			bench(threads, try_only);
+		}
+	}
+}
\ No newline at end of file
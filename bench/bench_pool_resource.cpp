@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <stltoys/pool_resource.h>
+
+namespace {
+	constexpr std::size_t threads = 16;
+	constexpr std::size_t ops_per_thread = 2'000'000;
+	constexpr std::size_t live_blocks = 256;
+
+	struct new_delete {
+		static auto allocate(std::size_t bytes) ->void* {
+			return std::allocator<unsigned char>{}.allocate(bytes);
+		}
+
+		static auto deallocate(void* p, std::size_t bytes) ->void {
+			std::allocator<unsigned char>{}.deallocate(static_cast<unsigned char*>(p), bytes);
+		}
+	};
+
+	struct pooled {
+		static auto allocate(std::size_t bytes) ->void* {
+			return ccat::pool_resource::default_resource().allocate(bytes);
+		}
+
+		static auto deallocate(void* p, std::size_t bytes) ->void {
+			ccat::pool_resource::default_resource().deallocate(p, bytes);
+		}
+	};
+
+	template<typename Resource>
+	auto churn(std::size_t seed) ->std::size_t { // replaces a random live block with a fresh one of 16 to 256 bytes
+		struct block {
+			void* ptr;
+			std::size_t bytes;
+		};
+		std::vector<block> live(live_blocks);
+		auto state = seed * 0x9e3779b97f4a7c15ull + 1;
+		auto next = [&] {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		};
+		for (auto& b : live) {
+			b.bytes = 16 + next() % 241;
+			b.ptr = Resource::allocate(b.bytes);
+		}
+		std::size_t checksum = 0;
+		for (std::size_t i = 0; i < ops_per_thread; ++i) {
+			auto r = next();
+			auto& b = live[r % live_blocks];
+			Resource::deallocate(b.ptr, b.bytes);
+			b.bytes = 16 + (r >> 32) % 241;
+			b.ptr = Resource::allocate(b.bytes);
+			*static_cast<unsigned char*>(b.ptr) = static_cast<unsigned char>(i);
+			checksum += reinterpret_cast<std::uintptr_t>(b.ptr) & 0xff;
+		}
+		for (auto& b : live) Resource::deallocate(b.ptr, b.bytes);
+		return checksum;
+	}
+
+	template<typename Resource>
+	auto run(const char* name) ->void {
+		std::vector<std::thread> workers;
+		std::vector<std::size_t> sums(threads);
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t t = 0; t < threads; ++t) {
+			workers.emplace_back([&sums, t] { sums[t] = churn<Resource>(t + 1); });
+		}
+		for (auto& worker : workers) worker.join();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::size_t sum = 0;
+		for (auto s : sums) sum += s;
+		std::printf("%-28s %8.2f Mops/s  (checksum %zu)\n", name, threads * ops_per_thread / elapsed.count() / 1e6, sum);
+	}
+}
+
+auto main() ->int {
+	run<new_delete>("std::allocator");
+	run<pooled>("ccat::pool_resource");
+}
\ No newline at end of file
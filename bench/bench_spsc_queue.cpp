@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <stltoys/spsc_queue.h>
+#include <stltoys/queue.h>
+
+namespace {
+	constexpr std::size_t items = 20'000'000;
+	constexpr std::size_t capacity = 4096;
+	constexpr std::size_t batch = 64;
+
+	template<typename Producer, typename Consumer>
+	auto run(const char* name, Producer producer, Consumer consumer) ->void {
+		auto start = std::chrono::steady_clock::now();
+		std::thread producer_thread{producer};
+		auto sum = consumer();
+		producer_thread.join();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::printf("%-28s %8.2f Mops/s  (checksum %zu)\n", name, items / elapsed.count() / 1e6, sum);
+	}
+
+	auto bench_spsc_single() ->void {
+		ccat::spsc_queue<std::size_t> queue{capacity};
+		run("spsc_queue push/pop", [&] {
+			for (std::size_t i = 0; i < items; ++i) queue.push(i);
+		}, [&] {
+			std::size_t sum = 0;
+			for (std::size_t i = 0; i < items; ++i) {
+				std::size_t value;
+				while (!queue.try_pop(value)) std::this_thread::yield();
+				sum += value;
+			}
+			return sum;
+		});
+	}
+
+	auto bench_spsc_batch() ->void {
+		ccat::spsc_queue<std::size_t> queue{capacity};
+		run("spsc_queue try_push_n/pop_n", [&] {
+			std::size_t values[batch];
+			for (std::size_t i = 0; i < items;) {
+				auto count = std::min(batch, items - i);
+				for (std::size_t j = 0; j < count; ++j) values[j] = i + j;
+				std::size_t pushed = 0;
+				while (pushed < count) {
+					auto n = queue.try_push_n(values + pushed, count - pushed);
+					if (n == 0) std::this_thread::yield();
+					pushed += n;
+				}
+				i += count;
+			}
+		}, [&] {
+			std::size_t sum = 0;
+			std::size_t values[batch];
+			for (std::size_t i = 0; i < items;) {
+				auto n = queue.try_pop_n(values, batch);
+				if (n == 0) std::this_thread::yield();
+				for (std::size_t j = 0; j < n; ++j) sum += values[j];
+				i += n;
+			}
+			return sum;
+		});
+	}
+
+	auto bench_mutex_queue() ->void {
+		ccat::queue<std::size_t> queue;
+		std::mutex mutex;
+		run("std::mutex + ccat::queue", [&] {
+			for (std::size_t i = 0; i < items;) {
+				{
+					std::lock_guard lock{mutex};
+					if (queue.size() < capacity) {
+						queue.push(i);
+						++i;
+						continue;
+					}
+				}
+				std::this_thread::yield();
+			}
+		}, [&] {
+			std::size_t sum = 0;
+			for (std::size_t i = 0; i < items;) {
+				{
+					std::lock_guard lock{mutex};
+					if (!queue.empty()) {
+						sum += queue.front();
+						queue.pop();
+						++i;
+						continue;
+					}
+				}
+				std::this_thread::yield();
+			}
+			return sum;
+		});
+	}
+}
+
+auto main() ->int {
+	bench_spsc_single();
+	bench_spsc_batch();
+	bench_mutex_queue();
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "detail/config.h"
+#include "detail/util.h"
+
+namespace ccat {
+	// Hands out memory by bumping a pointer through blocks obtained from `operator new`; each block is twice the size
+	// of the one before. `deallocate` only gives back the most recent allocation, everything else is freed at once by
+	// `reset`, which keeps the largest block so that the next round of work allocates nothing, or by `release`.
+	// Not thread-safe: one arena per thread or per request.
+	class monotonic_arena {
+	public:
+		using size_type = std::size_t;
+	public:
+		explicit monotonic_arena(size_type initial_size = 4096) noexcept : next_size_(std::max(initial_size, min_block_size)) {}
+
+		monotonic_arena(void* buffer, size_type size) noexcept : // serves from `buffer` first, e.g. an array on the stack
+			cur_(static_cast<std::byte*>(buffer)), end_(cur_ + size), buffer_(cur_), buffer_size_(size), next_size_(std::max(size * 2, min_block_size)) {}
+
+		monotonic_arena(const monotonic_arena&) = delete;
+
+		~monotonic_arena() {
+			release();
+		}
+	public:
+		auto operator= (const monotonic_arena&) ->monotonic_arena& = delete;
+
+		NODISCARD auto allocate(size_type bytes, size_type align = alignof(std::max_align_t)) ->void* {
+			void* p = cur_;
+			auto space = static_cast<size_type>(end_ - cur_);
+			if (!std::align(align, bytes, p, space)) [[unlikely]] {
+				add_block_(bytes + align);
+				p = cur_;
+				space = static_cast<size_type>(end_ - cur_);
+				std::align(align, bytes, p, space);
+			}
+			last_ = static_cast<std::byte*>(p);
+			cur_ = last_ + bytes;
+			return p;
+		}
+
+		auto deallocate(void* p, size_type bytes, size_type = alignof(std::max_align_t)) noexcept ->void {
+			if (p == last_ && last_ + bytes == cur_) cur_ = last_; // the most recent allocation can be taken back
+		}
+
+		NODISCARD auto resize(void* p, size_type old_bytes, size_type new_bytes) noexcept ->bool { // grows or shrinks the most recent allocation in place
+			if (p != last_ || last_ + old_bytes != cur_ || new_bytes > static_cast<size_type>(end_ - last_)) return false;
+			cur_ = last_ + new_bytes;
+			return true;
+		}
+
+		auto reset() noexcept ->void { // frees every allocation; the largest block stays for reuse
+			if (blocks_ == nullptr) {
+				cur_ = buffer_;
+				end_ = buffer_ + buffer_size_;
+			}
+			else {
+				free_blocks_(blocks_->prev);
+				blocks_->prev = nullptr;
+				cur_ = blocks_->data();
+				end_ = reinterpret_cast<std::byte*>(blocks_) + blocks_->size;
+			}
+			last_ = nullptr;
+		}
+
+		auto release() noexcept ->void { // frees every allocation and every block
+			free_blocks_(blocks_);
+			blocks_ = nullptr;
+			cur_ = buffer_;
+			end_ = buffer_ + buffer_size_;
+			last_ = nullptr;
+		}
+
+		NODISCARD auto remaining() const noexcept ->size_type { // bytes left in the current block
+			return static_cast<size_type>(end_ - cur_);
+		}
+	private:
+		struct alignas(std::max_align_t) block_header {
+			block_header* prev;
+			size_type size; // including the header
+
+			auto data() noexcept ->std::byte* {
+				return reinterpret_cast<std::byte*>(this + 1);
+			}
+		};
+
+		static constexpr size_type min_block_size = 256;
+
+		auto add_block_(size_type bytes) ->void {
+			if (bytes > std::numeric_limits<size_type>::max() / 2 - sizeof(block_header)) throw std::bad_alloc{};
+			auto size = std::max(next_size_, bytes + sizeof(block_header));
+			auto block = ::new (::operator new(size)) block_header{blocks_, size};
+			blocks_ = block;
+			cur_ = block->data();
+			end_ = reinterpret_cast<std::byte*>(block) + size;
+			next_size_ = size > std::numeric_limits<size_type>::max() / 2 ? size : size * 2;
+		}
+
+		static auto free_blocks_(block_header* block) noexcept ->void {
+			while (block != nullptr) {
+				auto prev = block->prev;
+				::operator delete(static_cast<void*>(block), block->size);
+				block = prev;
+			}
+		}
+	private:
+		std::byte* cur_{};
+		std::byte* end_{};
+		std::byte* last_{}; // the most recent allocation
+		block_header* blocks_{}; // newest first
+		std::byte* buffer_{};
+		size_type buffer_size_{};
+		size_type next_size_{};
+	};
+
+	// Allocates from a `monotonic_arena` the caller keeps alive. Containers stay with the arena they were built with:
+	// copies are made in the same arena, and assignment or swap never moves an allocator between containers, so a
+	// container moved into one that lives in another arena copies its elements over.
+	template<typename T>
+	class arena_allocator {
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::false_type;
+		using propagate_on_container_swap = std::false_type;
+		using is_always_equal = std::false_type;
+	public:
+		arena_allocator(monotonic_arena& arena) noexcept : arena_(std::addressof(arena)) {}
+
+		template<typename U>
+		arena_allocator(const arena_allocator<U>& other) noexcept : arena_(other.arena()) {}
+	public:
+		NODISCARD auto allocate(size_type n) ->T* {
+			if (n > std::numeric_limits<size_type>::max() / sizeof(T)) throw std::bad_array_new_length{};
+			return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		auto deallocate(T* p, size_type n) noexcept ->void {
+			arena_->deallocate(static_cast<void*>(p), n * sizeof(T), alignof(T));
+		}
+
+		// grows the most recent allocation in place when the block has room, otherwise moves the bytes to a new one
+		NODISCARD auto reallocate(T* p, size_type old_n, size_type new_n) ->allocation_result<T*> {
+			if (new_n <= std::numeric_limits<size_type>::max() / sizeof(T) && arena_->resize(static_cast<void*>(p), old_n * sizeof(T), new_n * sizeof(T))) {
+				return {p, new_n};
+			}
+			auto q = allocate(new_n);
+			std::memcpy(static_cast<void*>(q), static_cast<const void*>(p), std::min(old_n, new_n) * sizeof(T));
+			deallocate(p, old_n);
+			return {q, new_n};
+		}
+
+		NODISCARD auto arena() const noexcept ->monotonic_arena* {
+			return arena_;
+		}
+
+		template<typename U>
+		friend auto operator== (const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept ->bool {
+			return lhs.arena_ == rhs.arena();
+		}
+	private:
+		monotonic_arena* arena_;
+	};
+}
\ No newline at end of file
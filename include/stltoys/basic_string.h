@@ -1,12 +1,16 @@
 #pragma once
+#include <functional>
 #include <initializer_list>
+#include <ranges>
 #include "detail/basic_string_base.h"
+#include "detail/concepts.h"
+#include "str_cat.h"
 
 namespace ccat {
-	template<typename CharT, typename Traits, typename Alloc>
-	class basic_string : public detail::basic_string_base<CharT, Traits, Alloc> {
+	template<typename CharT, typename Traits, typename Alloc, typename GrowthPolicy, typename Layout>
+	class basic_string : public detail::basic_string_base<CharT, Traits, Alloc, Layout> {
 	private:
-		using base = detail::basic_string_base<CharT, Traits, Alloc>;
+		using base = detail::basic_string_base<CharT, Traits, Alloc, Layout>;
 		using typename base::slice_type;
 		using typename base::view_type;
 		using typename base::allocator_traits;
@@ -14,6 +18,8 @@ namespace ccat {
 		using typename base::value_type;
 		using typename base::traits_type;
 		using typename base::allocator_type;
+		using growth_policy_type = GrowthPolicy;
+		using layout_type = Layout;
 		using typename base::size_type;
 		using typename base::difference_type;
 		using typename base::pointer;
@@ -43,7 +49,7 @@ namespace ccat {
 		
 		template<std::input_iterator InputIt> requires std::convertible_to<std::iter_value_t<InputIt>, value_type>
 		CONSTEXPR basic_string(InputIt first, InputIt last, const allocator_type& alloc =  allocator_type()) : base(alloc) {
-			for (auto it = first; it != last; ++it) push_back(*it);
+			replace_range_(0, 0, std::move(first), std::move(last));
 		}
 		
 		basic_string(const basic_string& other) = default;
@@ -125,8 +131,14 @@ namespace ccat {
 		
 		template<std::input_iterator InputIt>
 		CONSTEXPR auto assign(InputIt first, InputIt second) ->basic_string& {
-			clear();
-			return append(first, second);
+			replace_range_(0, size(), std::move(first), std::move(second));
+			return *this;
+		}
+		
+		template<concepts::container_compatible_range<CharT> Range>
+		CONSTEXPR auto assign_range(Range&& rng) ->basic_string& {
+			replace_range_(0, size(), std::forward<Range>(rng));
+			return *this;
 		}
 		
 		CONSTEXPR auto assgin(std::initializer_list<value_type> ilist) ->basic_string& {
@@ -145,60 +157,53 @@ namespace ccat {
 		}
 		
 		CONSTEXPR auto push_back(value_type c) ->void {
-			if (size() == capacity()) reserve(size() + (size() >> 1));
-			*slice_.end_ = c;
-			++slice_.end_;
+			auto size_ = size();
+			if (size_ == capacity()) reserve(grow_(size_ + 1));
+			begin_ptr()[size_] = c;
+			set_size(size_ + 1);
 			null_terminated();
 		}
 		
 		CONSTEXPR auto pop_back() ->void {
-			--slice_.end_;
+			set_size(size() - 1);
 			null_terminated();
 		}
 		
 		CONSTEXPR auto insert(size_type index, size_type count, value_type ch) ->basic_string& {
 			if (index > size()) throw std::out_of_range{"in function `ccat::basic_string::insert`: the parameter `index` is out of range"};
-			if (count <= (capacity() - size())) {
-				traits_type::move(slice_.beg_ + index + count, slice_.beg_ + index, size() - index);
-				traits_type::assign(slice_.beg_ + index, count, ch);
-				slice_.end_ += count;
+			auto size_ = size();
+			if (count <= (capacity() - size_)) {
+				auto beg = begin_ptr();
+				traits_type::move(beg + index + count, beg + index, size_ - index);
+				traits_type::assign(beg + index, count, ch);
+				set_size(size_ + count);
 				null_terminated();
 				return *this;
 			}
-			auto new_size = size() + count;
-			auto new_cap = std::max(size() + (size() >> 1), new_size);
-			auto new_space = allocate(new_cap);
-			traits_type::move(new_space, slice_.beg_, index);
-			traits_type::move(new_space + index + count, slice_.beg_ + index, size() - index);
-			traits_type::assign(new_space + index, count, ch);
-			deallocate();
-			slice_.beg_ = new_space;
-			slice_.end_ = new_space + new_size;
-			cap_ = new_space + new_cap;
-			null_terminated();
+			reallocate(grow_(size_ + count), size_ + count, [&](pointer new_space, const_pointer old_space) {
+				traits_type::move(new_space, old_space, index);
+				traits_type::move(new_space + index + count, old_space + index, size_ - index);
+				traits_type::assign(new_space + index, count, ch);
+			});
 			return *this;
 		}
 		
 		CONSTEXPR auto insert(size_type index, const_pointer s, size_type count) ->basic_string& {
 			if (index > size()) throw std::out_of_range{"in function `ccat::basic_string::insert`: the parameter `index` is out of range"};
-			if (count <= (capacity() - size())) {
-				traits_type::move(slice_.beg_ + index + count, slice_.beg_ + index, size() - index);
-				traits_type::move(slice_.beg_ + index, s, count);
-				slice_.end_ += count;
+			auto size_ = size();
+			if (count <= (capacity() - size_)) {
+				auto beg = begin_ptr();
+				traits_type::move(beg + index + count, beg + index, size_ - index);
+				traits_type::move(beg + index, s, count);
+				set_size(size_ + count);
 				null_terminated();
 				return *this;
 			}
-			auto new_size = size() + count;
-			auto new_cap = std::max(size() + (size() >> 1), new_size);
-			auto new_space = allocate(new_cap);
-			traits_type::move(new_space, slice_.beg_, index);
-			traits_type::move(new_space + index + count, slice_.beg_ + index, size() - index);
-			traits_type::move(new_space + index, s, count);
-			deallocate();
-			slice_.beg_ = new_space;
-			slice_.end_ = new_space + new_size;
-			cap_ = new_space + new_cap;
-			null_terminated();
+			reallocate(grow_(size_ + count), size_ + count, [&](pointer new_space, const_pointer old_space) {
+				traits_type::move(new_space, old_space, index);
+				traits_type::move(new_space + index + count, old_space + index, size_ - index);
+				traits_type::move(new_space + index, s, count); // `s` may point into the old buffer, which is still alive
+			});
 			return *this;
 		}
 		
@@ -222,15 +227,20 @@ namespace ccat {
 		}
 		
 		CONSTEXPR auto insert(const_iterator pos, value_type ch) ->iterator {
-			insert(pos, 1, ch);
+			return insert(pos, 1, ch);
 		}
 		
 		template<std::input_iterator InputIt>
 		CONSTEXPR auto insert(const_iterator pos, InputIt first, InputIt last) ->iterator {
-			auto index = pos - cbegin();
-			for (auto it = first; it != last; ++it) {
-				pos = insert(pos, *it);
-			}
+			auto index = static_cast<size_type>(pos - cbegin());
+			replace_range_(index, 0, std::move(first), std::move(last));
+			return begin() + index;
+		}
+		
+		template<concepts::container_compatible_range<CharT> Range>
+		CONSTEXPR auto insert_range(const_iterator pos, Range&& rng) ->iterator {
+			auto index = static_cast<size_type>(pos - cbegin());
+			replace_range_(index, 0, std::forward<Range>(rng));
 			return begin() + index;
 		}
 		
@@ -272,7 +282,13 @@ namespace ccat {
 		
 		template<std::input_iterator InputIt>
 		CONSTEXPR auto append(InputIt first, InputIt last) ->basic_string& {
-			insert(end(), first, last);
+			replace_range_(size(), 0, std::move(first), std::move(last));
+			return *this;
+		}
+		
+		template<concepts::container_compatible_range<CharT> Range>
+		CONSTEXPR auto append_range(Range&& rng) ->basic_string& {
+			replace_range_(size(), 0, std::forward<Range>(rng));
 			return *this;
 		}
 		
@@ -290,80 +306,64 @@ namespace ccat {
 			return insert(size(), static_cast<view_type>(t).substr(pos, count));
 		}
 		
-		friend CONSTEXPR auto operator+ (const basic_string& lhs, const basic_string& rhs) ->basic_string {
-			auto res = lhs;
-			res.append(rhs);
-			return res;
+		// `+` only records its operands; the `detail::string_concat` it returns becomes a `basic_string` with one allocation
+		friend CONSTEXPR auto operator+ (const basic_string& lhs, const basic_string& rhs) ->detail::string_concat<basic_string, view_type, view_type> {
+			return {lhs.get_allocator(), {lhs, rhs}};
 		}
 		
-		friend CONSTEXPR auto operator+ (const basic_string& lhs, const_pointer rhs) ->basic_string {
-			auto res = lhs;
-			res.append(rhs);
-			return res;
+		friend CONSTEXPR auto operator+ (const basic_string& lhs, const_pointer rhs) ->detail::string_concat<basic_string, view_type, view_type> {
+			return {lhs.get_allocator(), {lhs, rhs}};
 		}
 		
-		friend CONSTEXPR auto operator+ (const basic_string& lhs, value_type rhs) ->basic_string {
-			auto res = lhs;
-			res.append(rhs);
-			return res;
+		friend CONSTEXPR auto operator+ (const basic_string& lhs, value_type rhs) ->detail::string_concat<basic_string, view_type, value_type> {
+			return {lhs.get_allocator(), {lhs, rhs}};
 		}
 		
-		friend CONSTEXPR auto operator+ (const_pointer lhs, const basic_string& rhs) ->basic_string {
-			basic_string res(lhs, rhs.get_allocator());
-			res.append(rhs);
-			return res;
+		friend CONSTEXPR auto operator+ (const_pointer lhs, const basic_string& rhs) ->detail::string_concat<basic_string, view_type, view_type> {
+			return {rhs.get_allocator(), {lhs, rhs}};
 		}
 		
-		friend CONSTEXPR auto operator+ (value_type lhs, const basic_string& rhs) ->basic_string {
-			basic_string res(1, lhs, rhs.get_allocator());
-			res.append(rhs);
-			return res;
+		friend CONSTEXPR auto operator+ (value_type lhs, const basic_string& rhs) ->detail::string_concat<basic_string, value_type, view_type> {
+			return {rhs.get_allocator(), {lhs, rhs}};
 		}
 		
-		friend CONSTEXPR auto operator+ (basic_string&& lhs, basic_string&& rhs) ->basic_string {
-			basic_string res = std::move(lhs);
-			basic_string rhs_ = std::move(rhs);
-			res.append(rhs_);
-			return res;
+		friend CONSTEXPR auto operator+ (basic_string&& lhs, basic_string&& rhs) ->detail::string_concat<basic_string, basic_string, basic_string> {
+			auto alloc = lhs.get_allocator();
+			return {alloc, {keep_(lhs, rhs), std::move(rhs)}};
 		}
 		
-		friend CONSTEXPR auto operator+ (basic_string&& lhs, const basic_string& rhs) ->basic_string {
-			basic_string res = std::move(lhs);
-			res.append(rhs);
-			return res;
+		friend CONSTEXPR auto operator+ (basic_string&& lhs, const basic_string& rhs) ->detail::string_concat<basic_string, basic_string, view_type> {
+			auto alloc = lhs.get_allocator();
+			view_type view = rhs; // taken before `lhs` is moved from
+			return {alloc, {keep_(lhs, view), view}};
 		}
 		
-		friend CONSTEXPR auto operator+ (basic_string&& lhs, const_pointer rhs) ->basic_string {
-			basic_string res = std::move(lhs);
-			res.append(rhs);
-			return res;
+		friend CONSTEXPR auto operator+ (basic_string&& lhs, const_pointer rhs) ->detail::string_concat<basic_string, basic_string, view_type> {
+			auto alloc = lhs.get_allocator();
+			view_type view = rhs;
+			return {alloc, {keep_(lhs, view), view}};
 		}
 		
-		friend CONSTEXPR auto operator+ (basic_string&& lhs, value_type rhs) ->basic_string {
-			basic_string res = std::move(lhs);
-			res.append(rhs);
-			return res;
+		friend CONSTEXPR auto operator+ (basic_string&& lhs, value_type rhs) ->detail::string_concat<basic_string, basic_string, value_type> {
+			auto alloc = lhs.get_allocator();
+			return {alloc, {std::move(lhs), rhs}};
 		}
 		
-		friend CONSTEXPR auto operator+ (const basic_string& lhs, basic_string&& rhs) ->basic_string {
-			basic_string res(lhs, rhs.get_allocator());
-			basic_string rhs_ = std::move(rhs);
-			res.append(rhs_);
-			return res;
+		friend CONSTEXPR auto operator+ (const basic_string& lhs, basic_string&& rhs) ->detail::string_concat<basic_string, view_type, basic_string> {
+			auto alloc = rhs.get_allocator();
+			view_type view = lhs;
+			return {alloc, {view, keep_(rhs, view)}};
 		}
 		
-		friend CONSTEXPR auto operator+ (const_pointer lhs, basic_string&& rhs) ->basic_string {
-			basic_string res(lhs, rhs.get_allocator());
-			basic_string rhs_ = std::move(rhs);
-			res.append(rhs_);
-			return res;
+		friend CONSTEXPR auto operator+ (const_pointer lhs, basic_string&& rhs) ->detail::string_concat<basic_string, view_type, basic_string> {
+			auto alloc = rhs.get_allocator();
+			view_type view = lhs;
+			return {alloc, {view, keep_(rhs, view)}};
 		}
 		
-		friend CONSTEXPR auto operator+ (value_type lhs, basic_string&& rhs) ->basic_string {
-			basic_string res(1, lhs, rhs.get_allocator());
-			basic_string rhs_ = std::move(rhs);
-			res.append(rhs_);
-			return res;
+		friend CONSTEXPR auto operator+ (value_type lhs, basic_string&& rhs) ->detail::string_concat<basic_string, value_type, basic_string> {
+			auto alloc = rhs.get_allocator();
+			return {alloc, {lhs, std::move(rhs)}};
 		}
 		
 		CONSTEXPR auto operator+= (const basic_string& other) ->basic_string& {
@@ -390,17 +390,19 @@ namespace ccat {
 		CONSTEXPR auto erase(size_type index = 0, size_type count = npos) ->basic_string& {
 			if (index > size()) throw std::out_of_range{"in function `ccat::basic_string::erase`: the parameter `index` is out of range"};
 			count = std::min(count, size() - index);
-			traits_type::move(slice_.beg_ + index, slice_.beg_ + index + count, size() - (index + count));
-			slice_.end_ -= count;
+			auto beg = begin_ptr();
+			traits_type::move(beg + index, beg + index + count, size() - (index + count));
+			set_size(size() - count);
 			null_terminated();
 			return *this;
 		}
 		
 		CONSTEXPR auto erase(const_iterator pos) ->iterator {
+			auto beg = begin_ptr();
 			for (size_type i = pos - cbegin(); i < size(); ++i) {
-				traits_type::assign(slice_.beg_[i], slice_.beg_[i+1]);
+				traits_type::assign(beg[i], beg[i+1]);
 			}
-			--slice_.end_;
+			set_size(size() - 1);
 			null_terminated();
 			return begin() + (pos - cbegin());
 		}
@@ -408,8 +410,9 @@ namespace ccat {
 		CONSTEXPR auto erase(const_iterator first, const_iterator last) ->iterator {
 			auto index = first - cbegin();
 			auto count = last - first;
-			traits_type::move(slice_.beg_ + index, slice_.beg_ + index + count, size() - (index + count));
-			slice_.end_ -= count;
+			auto beg = begin_ptr();
+			traits_type::move(beg + index, beg + index + count, size() - (index + count));
+			set_size(size() - count);
 			null_terminated();
 			return begin() + index;
 		}
@@ -453,7 +456,7 @@ namespace ccat {
 		
 		template<std::input_iterator InputIt>
 		CONSTEXPR auto replace(const_iterator first, const_iterator last, InputIt first2, InputIt last2) ->basic_string& {
-			insert(erase(first, last), first2, last2);
+			replace_range_(static_cast<size_type>(first - cbegin()), static_cast<size_type>(last - first), std::move(first2), std::move(last2));
 			return *this;
 		}
 		
@@ -480,39 +483,39 @@ namespace ccat {
 		}
 		
 		CONSTEXPR operator view_type() const noexcept {
-			return view_type{slice_.beg_, slice_.size()};
+			return view_type{begin_ptr(), size()};
 		}
 		
 		NODISCARD CONSTEXPR auto begin() noexcept ->iterator {
-			return slice_.begin();
+			return as_slice().begin();
 		}
 		
 		NODISCARD CONSTEXPR auto begin() const noexcept ->const_iterator {
-			return slice_.cbegin();
+			return as_slice().cbegin();
 		}
 		
 		NODISCARD CONSTEXPR auto end() noexcept ->iterator {
-			return slice_.end();
+			return as_slice().end();
 		}
 		
 		NODISCARD CONSTEXPR auto end() const noexcept ->const_iterator {
-			return slice_.cend();
+			return as_slice().cend();
 		}
 		
 		NODISCARD CONSTEXPR auto rbegin() noexcept ->reverse_iterator {
-			return slice_.rbegin();
+			return as_slice().rbegin();
 		}
 		
 		NODISCARD CONSTEXPR auto rbegin() const noexcept ->const_reverse_iterator {
-			return slice_.crbegin();
+			return as_slice().crbegin();
 		}
 		
 		NODISCARD CONSTEXPR auto rend() noexcept ->reverse_iterator {
-			return slice_.rend();
+			return as_slice().rend();
 		}
 		
 		NODISCARD CONSTEXPR auto rend() const noexcept ->const_reverse_iterator {
-			return slice_.crend();
+			return as_slice().crend();
 		}
 		
 		NODISCARD CONSTEXPR auto cbegin() const noexcept ->const_iterator {
@@ -532,47 +535,47 @@ namespace ccat {
 		}
 		
 		NODISCARD CONSTEXPR auto at(size_type pos) ->reference {
-			return slice_.at(pos);
+			return as_slice().at(pos);
 		}
 		
 		NODISCARD CONSTEXPR auto at(size_type pos) const ->const_reference {
-			return slice_.at(pos);
+			return as_slice().at(pos);
 		}
 		
 		NODISCARD CONSTEXPR auto operator[] (size_type pos) noexcept ->reference {
-			return slice_[pos];
+			return as_slice()[pos];
 		}
 		
 		NODISCARD CONSTEXPR auto operator[] (size_type pos) const noexcept ->const_reference {
-			return slice_[pos];
+			return as_slice()[pos];
 		}
 		
 		NODISCARD CONSTEXPR auto front() noexcept ->reference {
-			return slice_.front();
+			return as_slice().front();
 		}
 		
 		NODISCARD CONSTEXPR auto front() const noexcept ->const_reference {
-			return slice_.front();
+			return as_slice().front();
 		}
 		
 		NODISCARD CONSTEXPR auto back() noexcept ->reference {
-			return slice_.back();
+			return as_slice().back();
 		}
 		
 		NODISCARD CONSTEXPR auto back() const noexcept ->const_reference {
-			return slice_.back();
+			return as_slice().back();
 		}
 		
 		NODISCARD CONSTEXPR auto data() noexcept ->pointer {
-			return slice_.data();
+			return as_slice().data();
 		}
 		
 		NODISCARD CONSTEXPR auto data() const noexcept ->const_pointer {
-			return slice_.data();
+			return as_slice().data();
 		}
 		
 		NODISCARD CONSTEXPR auto c_str() const noexcept ->const_pointer {
-			return slice_.data();
+			return as_slice().data();
 		}
 		
 		NODISCARD CONSTEXPR auto get_allocator() const ->allocator_type {
@@ -580,208 +583,208 @@ namespace ccat {
 		}
 		
 		NODISCARD CONSTEXPR auto find(const basic_string& str, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find(str, pos);
+			return as_slice().find(str, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find(const_pointer s, size_type pos, size_type count) const noexcept ->size_type {
-			return slice_.find(s, pos, count);
+			return as_slice().find(s, pos, count);
 		}
 		
 		NODISCARD CONSTEXPR auto find(const_pointer s, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find(s, pos);
+			return as_slice().find(s, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find(value_type c, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find(c, pos);
+			return as_slice().find(c, pos);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto find(const StringViewLike& sv, size_type pos = 0) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, view_type>) ->size_type {
-			return slice_.find(sv, pos);
+			return as_slice().find(sv, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto rfind(const basic_string& str, size_type pos = npos) const noexcept ->size_type {
-			return slice_.rfind(str, pos);
+			return as_slice().rfind(str, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto rfind(const_pointer s, size_type pos, size_type count) const noexcept ->size_type {
-			return slice_.rfind(s, pos, count);
+			return as_slice().rfind(s, pos, count);
 		}
 		
 		NODISCARD CONSTEXPR auto rfind(const_pointer s, size_type pos = npos) const noexcept ->size_type {
-			return slice_.rfind(s, pos);
+			return as_slice().rfind(s, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto rfind(value_type c, size_type pos = npos) const noexcept ->size_type {
-			return slice_.rfind(c, pos);
+			return as_slice().rfind(c, pos);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto rfind(const StringViewLike& sv, size_type pos = npos) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, view_type>) ->size_type {
-			return slice_.rfind(sv, pos);
+			return as_slice().rfind(sv, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_first_of(const basic_string& str, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find_first_of(str, pos);
+			return as_slice().find_first_of(str, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_first_of(const_pointer s, size_type pos, size_type count) const noexcept ->size_type {
-			return slice_.find_first_of(s, pos, count);
+			return as_slice().find_first_of(s, pos, count);
 		}
 		
 		NODISCARD CONSTEXPR auto find_first_of(const_pointer s, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find_first_of(s, pos);
+			return as_slice().find_first_of(s, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_first_of(value_type c, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find_first_of(c, pos);
+			return as_slice().find_first_of(c, pos);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto find_first_of(const StringViewLike& sv, size_type pos = 0) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, view_type>) ->size_type {
-			return slice_.find_first_of(sv, pos);
+			return as_slice().find_first_of(sv, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_first_not_of(const basic_string& str, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find_first_not_of(str, pos);
+			return as_slice().find_first_not_of(str, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_first_not_of(const_pointer s, size_type pos, size_type count) const noexcept ->size_type {
-			return slice_.find_first_not_of(s, pos, count);
+			return as_slice().find_first_not_of(s, pos, count);
 		}
 		
 		NODISCARD CONSTEXPR auto find_first_not_of(const_pointer s, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find_first_not_of(s, pos);
+			return as_slice().find_first_not_of(s, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_first_not_of(value_type c, size_type pos = 0) const noexcept ->size_type {
-			return slice_.find_first_not_of(c, pos);
+			return as_slice().find_first_not_of(c, pos);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto find_first_not_of(const StringViewLike& sv, size_type pos = 0) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, view_type>) ->size_type {
-			return slice_.find_first_not_of(sv, pos);
+			return as_slice().find_first_not_of(sv, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_last_of(const basic_string& str, size_type pos = npos) const noexcept ->size_type {
-			return slice_.find_last_of(str, pos);
+			return as_slice().find_last_of(str, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_last_of(const_pointer s, size_type pos, size_type count) const noexcept ->size_type {
-			return slice_.find_last_of(s, pos, count);
+			return as_slice().find_last_of(s, pos, count);
 		}
 		
 		NODISCARD CONSTEXPR auto find_last_of(const_pointer s, size_type pos = npos) const noexcept ->size_type {
-			return slice_.find_last_of(s, pos);
+			return as_slice().find_last_of(s, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_last_of(value_type c, size_type pos = npos) const noexcept ->size_type {
-			return slice_.find_last_of(c, pos);
+			return as_slice().find_last_of(c, pos);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto find_last_of(const StringViewLike& sv, size_type pos = npos) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, view_type>) ->size_type {
-			return slice_.find_last_of(sv, pos);
+			return as_slice().find_last_of(sv, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_last_not_of(const basic_string& str, size_type pos = npos) const noexcept ->size_type {
-			return slice_.find_last_not_of(str, pos);
+			return as_slice().find_last_not_of(str, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_last_not_of(const_pointer s, size_type pos, size_type count) const noexcept ->size_type {
-			return slice_.find_last_not_of(s, pos, count);
+			return as_slice().find_last_not_of(s, pos, count);
 		}
 		
 		NODISCARD CONSTEXPR auto find_last_not_of(const_pointer s, size_type pos = npos) const noexcept ->size_type {
-			return slice_.find_last_not_of(s, pos);
+			return as_slice().find_last_not_of(s, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto find_last_not_of(value_type c, size_type pos = npos) const noexcept ->size_type {
-			return slice_.find_last_not_of(c, pos);
+			return as_slice().find_last_not_of(c, pos);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto find_last_not_of(const StringViewLike& sv, size_type pos = npos) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, view_type>) ->size_type {
-			return slice_.find_last_not_of(sv, pos);
+			return as_slice().find_last_not_of(sv, pos);
 		}
 		
 		NODISCARD CONSTEXPR auto starts_with(view_type sv) const noexcept ->bool {
-			return slice_.starts_with(sv);
+			return as_slice().starts_with(sv);
 		}
 		
 		NODISCARD CONSTEXPR auto starts_with(value_type c) const noexcept ->bool {
-			return slice_.starts_with(c);
+			return as_slice().starts_with(c);
 		}
 		
 		NODISCARD CONSTEXPR auto starts_with(const_pointer s) const noexcept ->bool {
-			return slice_.starts_with(s);
+			return as_slice().starts_with(s);
 		}
 		
 		NODISCARD CONSTEXPR auto ends_with(view_type sv) const noexcept ->bool {
-			return slice_.ends_with(sv);
+			return as_slice().ends_with(sv);
 		}
 		
 		NODISCARD CONSTEXPR auto ends_with(value_type c) const noexcept ->bool {
-			return slice_.ends_with(c);
+			return as_slice().ends_with(c);
 		}
 		
 		NODISCARD CONSTEXPR auto ends_with(const_pointer s) const noexcept ->bool {
-			return slice_.ends_with(s);
+			return as_slice().ends_with(s);
 		}
 		
 		NODISCARD CONSTEXPR auto contains(view_type sv) const noexcept ->bool {
-			return slice_.contains(sv);
+			return as_slice().contains(sv);
 		}
 		
 		NODISCARD CONSTEXPR auto contains(value_type c) const noexcept ->bool {
-			return slice_.contains(c);
+			return as_slice().contains(c);
 		}
 		
 		NODISCARD CONSTEXPR auto contains(const_pointer s) const noexcept ->bool {
-			return slice_.contains(s);
+			return as_slice().contains(s);
 		}
 		
 		NODISCARD CONSTEXPR auto compare(const basic_string& str) const noexcept ->int {
-			return slice_.compare(str.slice_);
+			return as_slice().compare(str.as_slice());
 		}
 		
 		NODISCARD CONSTEXPR auto compare(size_type pos1, size_type count1, const basic_string& str) const ->int {
-			return slice_.compare(pos1, count1, str.slice_);
+			return as_slice().compare(pos1, count1, str.as_slice());
 		}
 		
 		NODISCARD CONSTEXPR auto compare(size_type pos1, size_type count1, const basic_string& str, size_type pos2, size_type count2) const ->int {
-			return slice_.compare(pos1, count1, str, pos2, count2);
+			return as_slice().compare(pos1, count1, str, pos2, count2);
 		}
 		
 		NODISCARD CONSTEXPR auto compare(const_pointer s) const ->int {
-			return slice_.compare(s);
+			return as_slice().compare(s);
 		}
 		
 		NODISCARD CONSTEXPR auto compare(size_type pos1, size_type count1, const_pointer s) const ->int {
-			return slice_.compare(pos1, count1, s);
+			return as_slice().compare(pos1, count1, s);
 		}
 		
 		NODISCARD CONSTEXPR auto compare(size_type pos1, size_type count1, const_pointer s, size_type count2) const ->int {
-			return slice_.compare(pos1, count1, s, count2);
+			return as_slice().compare(pos1, count1, s, count2);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto compare(const StringViewLike& sv) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, view_type>) ->int {
-			return slice_.compare(sv);
+			return as_slice().compare(sv);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto compare(size_type pos1, size_type count1, const StringViewLike& sv) const ->int {
-			return slice_.compare(pos1, count1, sv);
+			return as_slice().compare(pos1, count1, sv);
 		}
 		
 		template<typename StringViewLike> requires std::convertible_to<const StringViewLike&, view_type> && (!std::convertible_to<const StringViewLike&, const_pointer>)
 		NODISCARD CONSTEXPR auto compare(size_type pos1, size_type count1, const StringViewLike& sv, size_type pos2, size_type count2) const ->int {
-			return slice_.compare(pos1, count1, sv, pos2, count2);
+			return as_slice().compare(pos1, count1, sv, pos2, count2);
 		}
 		
 		CONSTEXPR auto copy(pointer dest, size_type count, size_type pos = 0) const ->size_type {
-			return slice_.copy(dest, count, pos);
+			return as_slice().copy(dest, count, pos);
 		}
 		
 		CONSTEXPR auto swap(basic_string& other) noexcept(
@@ -791,70 +794,67 @@ namespace ccat {
 			swap(static_cast<base&>(other));
 		}
 		
-		CONSTEXPR auto substr(size_type pos = 0, size_type count = npos) const& ->basic_string {
-			return basic_string(*this, pos, count);
+		CONSTEXPR auto substr(size_type pos = 0, size_type count = npos) const& ->basic_string { // allocated like a copy of this string
+			return basic_string(*this, pos, count, allocator_traits::select_on_container_copy_construction(alloc_));
 		}
 		
 		CONSTEXPR auto substr(size_type pos = 0, size_type count = npos) && ->basic_string {
-			return basic_string(std::move(*this), pos, count);
+			return basic_string(std::move(*this), pos, count, allocator_traits::select_on_container_copy_construction(alloc_));
 		}
 		
 		CONSTEXPR auto slice(size_type pos = 0, size_type count = npos) & noexcept ->slice_type { // Cra3z extension
-			return slice_.substr(pos, count);
+			return as_slice().substr(pos, count);
 		}
 		
 		CONSTEXPR auto reserve(size_type new_cap) ->void {
 			if (new_cap <= capacity()) return; // noop
-			auto new_space = allocate(new_cap);
-			size_type size_ = size();
-			traits_type::move(new_space, slice_.beg_, size_);
-			deallocate();
-			slice_.beg_ = new_space;
-			slice_.end_ = new_space + size_;
-			cap_ = new_space + new_cap;
-			null_terminated();
+			auto size_ = size();
+			reallocate(new_cap, size_, [&](pointer new_space, const_pointer old_space) {
+				traits_type::move(new_space, old_space, size_);
+			});
 		}
 		
 		CONSTEXPR auto shrink_to_fit() ->void {
 			if (capacity() == size() || capacity() == sso_size) return; // noop
 			auto size_ = size();
-			auto new_cap = std::max(size_, sso_size);
-			auto new_space = allocate(new_cap);
-			traits_type::move(new_space, slice_.beg_, size_);
-			deallocate();
-			slice_.beg_ = new_space;
-			slice_.end_ = new_space + size_;
-			cap_ = new_space + new_cap;
-			null_terminated();
+			reallocate(std::max(size_, sso_size), size_, [&](pointer new_space, const_pointer old_space) {
+				traits_type::move(new_space, old_space, size_);
+			});
 		}
 		
 		CONSTEXPR auto resize(size_type count, value_type c = null_char) ->void {
 			if (count > max_size()) throw std::length_error{"int function `ccat::basic_string::resize`: the parameter `count` is too big"};
+			auto old_size = size();
 			if (count <= capacity()) {
-				for (size_type i = size(); i < count; ++i) {
-					slice_.beg_[i] = c;
-				}
-				slice_.end_ = slice_.beg_ + count;
+				if (count > old_size) traits_type::assign(begin_ptr() + old_size, count - old_size, c);
+				set_size(count);
 				null_terminated();
 			}
 			else {
-				auto old_size = size();
-				auto new_cap = std::max(old_size + (old_size >> 1), count);
-				auto new_space = allocate(new_cap);
-				traits_type::move(new_space, slice_.beg_, old_size);
-				deallocate();
-				slice_.beg_ = new_space;
-				slice_.end_ = new_space + count;
-				cap_ = new_space + new_cap;
-				for (size_type i = old_size; i < count; ++i) {
-					slice_.beg_[i] = c;
-				}
-				null_terminated();
+				reallocate(grow_(count), count, [&](pointer new_space, const_pointer old_space) {
+					traits_type::move(new_space, old_space, old_size);
+					traits_type::assign(new_space + old_size, count - old_size, c);
+				});
 			}
 		}
 		
+		template<typename Operation> requires std::is_integral_v<std::invoke_result_t<Operation, pointer, size_type>>
+		CONSTEXPR auto resize_and_overwrite(size_type count, Operation op) ->void { // `op(data(), count)` writes the characters and returns the new size
+			if (count > max_size()) throw std::length_error{"in function `ccat::basic_string::resize_and_overwrite`: the parameter `count` is too big"};
+			auto buf = begin_ptr();
+			if (count > capacity()) {
+				auto size_ = size();
+				buf = reallocate(grow_(count), size_, [&](pointer new_space, const_pointer old_space) {
+					traits_type::move(new_space, old_space, size_);
+				});
+			}
+			auto new_size = static_cast<size_type>(std::move(op)(buf, count));
+			set_size(new_size);
+			null_terminated();
+		}
+		
 		friend CONSTEXPR auto operator== (const basic_string& lhs, const basic_string& rhs) noexcept ->bool {
-			return lhs.slice_ == rhs.slice_;
+			return lhs.as_slice() == rhs.as_slice();
 		}
 		
 		friend CONSTEXPR auto operator== (const basic_string& lhs, const_pointer rhs) noexcept ->bool {
@@ -862,7 +862,7 @@ namespace ccat {
 		}
 		
 		friend CONSTEXPR auto operator<=> (const basic_string& lhs, const basic_string& rhs) noexcept ->std::strong_ordering {
-			return lhs.slice_ <=> rhs.slice_;
+			return lhs.as_slice() <=> rhs.as_slice();
 		}
 		
 		friend CONSTEXPR auto operator<=> (const basic_string& lhs, const_pointer rhs) noexcept ->std::strong_ordering {
@@ -870,24 +870,117 @@ namespace ccat {
 		}
 		
 		friend auto operator<< (std::basic_ostream<CharT, std::char_traits<CharT>>& os, const basic_string& str) ->std::basic_ostream<CharT, std::char_traits<CharT>>& {
-			return os << str.slice_;
+			return os << str.as_slice();
 		}
 		
 	private:
-
+		NODISCARD CONSTEXPR auto grow_(size_type required) const noexcept ->size_type { // grows from the size, so a reserved string is not inflated further
+			return growth_policy_type::grow(size(), required, alloc_);
+		}
+		
+		NODISCARD static CONSTEXPR auto keep_(basic_string& str, view_type other) ->basic_string { // `str` moved out, or copied when `other` views its characters
+			if (!other.empty() && str.aliases_(other.data())) return basic_string(str);
+			return std::move(str);
+		}
+		
+		NODISCARD CONSTEXPR auto aliases_(const_pointer p) const noexcept ->bool { // whether `p` points into the characters of this string
+			auto beg = static_cast<const_pointer>(begin_ptr());
+			auto end = beg + size();
+			if (std::is_constant_evaluated()) { // unrelated pointers may only be compared for equality here
+				for (auto it = beg; it != end; ++it) {
+					if (it == p) return true;
+				}
+				return false;
+			}
+			return std::less_equal<const_pointer>{}(beg, p) && std::less<const_pointer>{}(p, end);
+		}
+		
+		template<typename It>
+		static CONSTEXPR auto copy_n_(It first, size_type n, pointer out) ->void {
+			if constexpr (std::contiguous_iterator<It> && std::same_as<std::iter_value_t<It>, value_type>) {
+				if (n != 0) traits_type::copy(out, std::to_address(first), n);
+			}
+			else {
+				for (; n != 0; --n, ++first, ++out) traits_type::assign(*out, static_cast<value_type>(*first));
+			}
+		}
+		
+		template<typename It>
+		CONSTEXPR auto replace_n_(size_type index, size_type count, It first, size_type n) ->void { // replaces `[index, index + count)` with `n` characters read from `first`, moving the tail once
+			if constexpr (std::contiguous_iterator<It> && std::same_as<std::iter_value_t<It>, value_type>) {
+				if (n != 0 && aliases_(std::to_address(first))) [[unlikely]] { // the source would be shifted or overwritten under our feet
+					basic_string tmp(std::to_address(first), n, get_allocator());
+					return replace_n_(index, count, tmp.data(), n);
+				}
+			}
+			auto size_ = size();
+			if (n > max_size() - (size_ - count)) throw std::length_error{"in function `ccat::basic_string::replace`: the result is too long"};
+			auto tail = size_ - index - count;
+			auto new_size = size_ - count + n;
+			if (new_size <= capacity()) {
+				if constexpr (!(std::contiguous_iterator<It> && std::same_as<std::iter_value_t<It>, value_type>)) {
+					if (n != 0) { // any other iterator may walk this very string, so read it out before the tail moves
+						basic_string tmp(get_allocator());
+						tmp.resize_and_overwrite(n, [&](pointer buf, size_type) {
+							copy_n_(std::move(first), n, buf);
+							return n;
+						});
+						return replace_n_(index, count, tmp.data(), n);
+					}
+				}
+				auto beg = begin_ptr();
+				if (n != count) traits_type::move(beg + index + n, beg + index + count, tail);
+				copy_n_(std::move(first), n, beg + index);
+				set_size(new_size);
+				null_terminated();
+				return;
+			}
+			reallocate(grow_(new_size), new_size, [&](pointer new_space, const_pointer old_space) {
+				traits_type::copy(new_space, old_space, index);
+				traits_type::copy(new_space + index + n, old_space + index + count, tail);
+				copy_n_(std::move(first), n, new_space + index);
+			});
+		}
+		
+		template<typename It, typename Sent>
+		CONSTEXPR auto replace_range_(size_type index, size_type count, It first, Sent last) ->void {
+			if constexpr (std::forward_iterator<It> || std::sized_sentinel_for<Sent, It>) { // the length is known up front
+				size_type n;
+				if constexpr (std::sized_sentinel_for<Sent, It>) n = static_cast<size_type>(last - first);
+				else n = static_cast<size_type>(std::ranges::distance(first, last));
+				replace_n_(index, count, std::move(first), n);
+			}
+			else if (count == 0 && index == size()) { // a single pass that only ever appends
+				for (; first != last; ++first) push_back(static_cast<value_type>(*first));
+			}
+			else { // buffer the input, then splice it in
+				basic_string tmp(get_allocator());
+				tmp.replace_range_(0, 0, std::move(first), std::move(last));
+				replace_n_(index, count, tmp.data(), tmp.size());
+			}
+		}
+		
+		template<typename Range>
+		CONSTEXPR auto replace_range_(size_type index, size_type count, Range&& rng) ->void {
+			if constexpr (std::ranges::sized_range<Range> && !std::ranges::forward_range<Range>) {
+				replace_n_(index, count, std::ranges::begin(rng), static_cast<size_type>(std::ranges::size(rng)));
+			}
+			else {
+				replace_range_(index, count, std::ranges::begin(rng), std::ranges::end(rng));
+			}
+		}
 	public:
 		static constexpr size_type npos = slice_type::npos;
 	private:
 		using base::null_char;
 		using base::alloc_;
 		using base::sso_size;
-		using base::slice_;
-		using base::cap_;
-		using base::allocate;
-		using base::deallocate;
+		using base::begin_ptr;
+		using base::as_slice;
+		using base::set_size;
+		using base::reallocate;
 		using base::null_terminated;
 		using base::swap;
-		using base::set_ptrs;
 	};
 	
 }
@@ -895,4 +988,9 @@ namespace ccat {
 namespace ccat {
 	using string = basic_string<char>;
 	using wstring = basic_string<wchar_t>;
+	using u8string = basic_string<char8_t>;
+	using u16string = basic_string<char16_t>;
+	using u32string = basic_string<char32_t>;
+	using compact_string = basic_string<char, char_traits<char>, std::allocator<char>, growth_policy::one_and_half, string_layout::compact>;
+	using compact_wstring = basic_string<wchar_t, char_traits<wchar_t>, std::allocator<wchar_t>, growth_policy::one_and_half, string_layout::compact>;
 }
\ No newline at end of file
@@ -1,13 +1,16 @@
 #pragma once
 #include "detail/iterator.h"
 #include "char_traits.h"
+#include "detail/string_search.h"
+#include "growth_policy.h"
+#include "string_layout.h"
 
 namespace ccat {
-	template<typename CharT, typename Traits = char_traits<CharT>, typename Alloc = std::allocator<CharT>>
+	template<typename CharT, typename Traits = char_traits<CharT>, typename Alloc = std::allocator<CharT>, typename GrowthPolicy = growth_policy::one_and_half, typename Layout = string_layout::pointers>
 	class basic_string;
 	
 	namespace detail {
-		template<typename CharT, typename Traits, typename Alloc>
+		template<typename CharT, typename Traits, typename Alloc, typename Layout>
 		class basic_string_base;
 		
 		template<bool Mutable, typename CharT, typename Traits>
@@ -20,10 +23,10 @@ namespace ccat {
 		
 		template<bool Mutable, typename CharT, typename Traits = char_traits<CharT>>
 		class basic_string_view_like {
-			template<typename CharT_, typename Traits_, typename Alloc>
+			template<typename CharT_, typename Traits_, typename Alloc, typename GrowthPolicy, typename Layout>
 			friend class ccat::basic_string;
 			
-			template<typename CharT_, typename Traits_, typename Alloc>
+			template<typename CharT_, typename Traits_, typename Alloc, typename Layout>
 			friend class basic_string_base;
 		public:
 			using value_type = CharT;
@@ -42,25 +45,6 @@ namespace ccat {
 		private:
 			using iter_pointer_type_ = std::conditional_t<Mutable, pointer, const_pointer>;
 			using iter_reference_type_ = std::conditional_t<Mutable, reference, const_reference>;
-		private:
-			template<bool FromLeftToRight>
-			static CONSTEXPR auto brute_force_search(readonly_view txt, readonly_view pat) noexcept ->size_type {
-				if (txt.size() < pat.size()) return npos;
-				size_type last = txt.size() - pat.size();
-				for (size_type i = 0; i <= last; ++i) {
-					size_type idx = FromLeftToRight ? i : last - i;
-					bool skip = false;
-					for (size_type j{}; j < pat.size(); ++j) {
-						if (txt[idx + j] != pat[j]) {
-							skip = true;
-							break;
-						}
-					}
-					if (!skip) return idx;
-				}
-				return npos;
-			}
-			
 		public: // constructors and destructors
 			CONSTEXPR basic_string_view_like() noexcept = default;
 			CONSTEXPR basic_string_view_like(std::nullptr_t) = delete;
@@ -252,8 +236,9 @@ namespace ccat {
 			}
 			
 			NODISCARD CONSTEXPR auto find(readonly_view other, size_type pos = 0) const noexcept ->size_type {
-				if (pos >= size() || other.size() > size()) return npos;
-				return brute_force_search<true>(readonly_view{beg_ + pos, end_}, other);
+				if (pos > size()) return npos;
+				auto idx = detail::search<traits_type>(beg_ + pos, size() - pos, other.data(), other.size());
+				return idx == npos ? npos : pos + idx;
 			}
 			
 			NODISCARD CONSTEXPR auto find(value_type c, size_type pos = 0) const noexcept ->size_type {
@@ -284,7 +269,7 @@ namespace ccat {
 				auto sz = size();
 				if (other.size() > sz) return npos;
 				auto last = pos >= sz ? sz : pos + std::min(sz - pos, other.size());
-				return brute_force_search<false>(readonly_view{beg_, last}, other);
+				return detail::rsearch<traits_type>(beg_, last, other.data(), other.size());
 			}
 			
 			NODISCARD CONSTEXPR auto rfind(value_type c, size_type pos = npos) const noexcept ->size_type {
@@ -301,10 +286,8 @@ namespace ccat {
 			
 			NODISCARD CONSTEXPR auto find_first_of(readonly_view chars, size_type pos = 0) const noexcept ->size_type {
 				if (pos >= size()) return npos;
-				for (size_type i = pos; i < size(); ++i) {
-					if (chars.contains(beg_[i])) return i;
-				}
-				return npos;
+				auto idx = detail::find_of<true, true, traits_type>(beg_ + pos, size() - pos, chars.data(), chars.size());
+				return idx == npos ? npos : pos + idx;
 			}
 			
 			NODISCARD CONSTEXPR auto find_first_of(value_type c, size_type pos = 0) const noexcept ->size_type {
@@ -321,11 +304,7 @@ namespace ccat {
 			
 			NODISCARD CONSTEXPR auto find_last_of(readonly_view chars, size_type pos = npos) const noexcept ->size_type {
 				if (empty()) return npos;
-				auto last = std::min(pos, size() - 1);
-				for (size_type i{}; i <= last; ++i) {
-					if (chars.contains(beg_[last - i])) return last - i;
-				}
-				return npos;
+				return detail::find_of<false, true, traits_type>(beg_, std::min(pos, size() - 1) + 1, chars.data(), chars.size());
 			}
 			
 			NODISCARD CONSTEXPR auto find_last_of(value_type c, size_type pos = npos) const noexcept ->size_type {
@@ -342,10 +321,8 @@ namespace ccat {
 			
 			NODISCARD CONSTEXPR auto find_first_not_of(readonly_view chars, size_type pos = 0) const noexcept ->size_type {
 				if (pos >= size()) return npos;
-				for (size_type i = pos; i < size(); ++i) {
-					if (!chars.contains(beg_[i])) return i;
-				}
-				return npos;
+				auto idx = detail::find_of<true, false, traits_type>(beg_ + pos, size() - pos, chars.data(), chars.size());
+				return idx == npos ? npos : pos + idx;
 			}
 			
 			NODISCARD CONSTEXPR auto find_first_not_of(value_type c, size_type pos = 0) const noexcept ->size_type {
@@ -362,11 +339,7 @@ namespace ccat {
 			
 			NODISCARD CONSTEXPR auto find_last_not_of(readonly_view chars, size_type pos = npos) const noexcept ->size_type {
 				if (empty()) return npos;
-				auto last = std::min(pos, size() - 1);
-				for (size_type i{}; i <= last; ++i) {
-					if (!chars.contains(beg_[last - i])) return last - i;
-				}
-				return npos;
+				return detail::find_of<false, false, traits_type>(beg_, std::min(pos, size() - 1) + 1, chars.data(), chars.size());
 			}
 			
 			NODISCARD CONSTEXPR auto find_last_not_of(value_type c, size_type pos = npos) const noexcept ->size_type {
@@ -382,7 +355,7 @@ namespace ccat {
 			}
 			
 			friend CONSTEXPR auto operator== (basic_string_view_like lhs, basic_string_view_like rhs) noexcept ->bool {
-				return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+				return lhs.size() == rhs.size() && detail::equal<traits_type>(lhs.data(), rhs.data(), lhs.size());
 			}
 			
 			friend CONSTEXPR auto operator<=> (basic_string_view_like lhs, basic_string_view_like rhs) noexcept ->std::strong_ordering {
@@ -412,8 +385,14 @@ namespace ccat {
 namespace ccat {
 	using string_view = basic_string_view<char>;
 	using wstring_view = basic_string_view<wchar_t>;
+	using u8string_view = basic_string_view<char8_t>;
+	using u16string_view = basic_string_view<char16_t>;
+	using u32string_view = basic_string_view<char32_t>;
 	using string_slice = basic_string_slice<char>;
 	using wstring_slice = basic_string_slice<wchar_t>;
+	using u8string_slice = basic_string_slice<char8_t>;
+	using u16string_slice = basic_string_slice<char16_t>;
+	using u32string_slice = basic_string_slice<char32_t>;
 }
 
 template<bool Mutable, class CharT, class Traits>
@@ -1,6 +1,10 @@
 #pragma once
 #include <cstring>
+#include <concepts>
+#include <cwchar>
 #include <ios>
+#include "detail/config.h"
+#include "detail/char_scan.h"
 
 namespace ccat {
 	
@@ -74,9 +78,14 @@ namespace ccat {
 			c1 = c2;
 		}
 		CONSTEXPR static auto assign(char_type* ptr, std::size_t count, char_type c) noexcept ->void {
-			for (std::size_t i{}; i < count; ++i) {
-				assign(ptr[i], c);
+			if (std::is_constant_evaluated()) {
+				for (std::size_t i{}; i < count; ++i) {
+					assign(ptr[i], c);
+				}
 			}
+			else if constexpr (sizeof(char_type) == 1) std::memset(ptr, static_cast<unsigned char>(c), count);
+			else if constexpr (std::same_as<char_type, wchar_t>) std::wmemset(ptr, c, count);
+			else detail::wide_fill(ptr, count, c);
 		}
 		CONSTEXPR static auto eq(char_type a, char_type b) noexcept ->bool {
 			return static_cast<cmp_type>(a) == static_cast<cmp_type>(b);
@@ -86,7 +95,9 @@ namespace ccat {
 		}
 		CONSTEXPR static auto move(char_type* dest, const char_type* src, std::size_t count) noexcept ->char_type* {
 			if (std::is_constant_evaluated()) {
-				if (dest > src) {
+				bool dest_inside_src = false; // `<` between unrelated arrays is not a constant expression, `==` is
+				for (std::size_t i = 1; i < count && !dest_inside_src; ++i) dest_inside_src = src + i == dest;
+				if (dest_inside_src) {
 					while (count > 0) {
 						dest[count - 1] = src[count - 1];
 						--count;
@@ -112,7 +123,8 @@ namespace ccat {
 		}
 		CONSTEXPR static auto default_compare(const char_type* s1, const char_type* s2, std::size_t count) noexcept ->int {
 			for (std::size_t i{}; i < count; ++i) {
-				if (auto cmp_res = to_int_type(s1[i]) - to_int_type(s2[i]); cmp_res != 0) return cmp_res;
+				if (lt(s1[i], s2[i])) return -1;
+				if (lt(s2[i], s1[i])) return 1;
 			}
 			return 0;
 		}
@@ -134,7 +146,7 @@ namespace ccat {
 	struct char_traits<char> : char_traits_base<char> {
 		CONSTEXPR static auto compare(const char_type* s1, const char_type* s2, std::size_t count) noexcept ->int {
 			if (std::is_constant_evaluated()) return default_compare(s1, s2, count);
-			else return std::strncmp(s1, s2, count);
+			else return std::memcmp(s1, s2, count); // compares as `unsigned char` and does not stop at '\0'
 		}
 		CONSTEXPR static auto length(const char_type* s) noexcept ->std::size_t {
 			if (std::is_constant_evaluated()) {
@@ -149,6 +161,7 @@ namespace ccat {
 		}
 		CONSTEXPR static auto find(const char_type* ptr, std::size_t count, const char_type& ch) noexcept ->const char_type* {
 			if (ptr == nullptr) return nullptr;
+			if (!std::is_constant_evaluated()) return static_cast<const char_type*>(std::memchr(ptr, static_cast<unsigned char>(ch), count));
 			for (std::size_t i{}; i < count; ++i) {
 				if (ptr[i] == ch) return ptr + i;
 			}
@@ -163,7 +176,7 @@ namespace ccat {
 	struct char_traits<wchar_t> : char_traits_base<wchar_t> {
 		CONSTEXPR static auto compare(const char_type* s1, const char_type* s2, std::size_t count) noexcept ->int {
 			if (std::is_constant_evaluated()) return default_compare(s1, s2, count);
-			else return std::wcsncmp(s1, s2, count);
+			else return std::wmemcmp(s1, s2, count);
 		}
 		CONSTEXPR static auto length(const char_type* s) noexcept ->std::size_t {
 			if (std::is_constant_evaluated()) {
@@ -178,6 +191,7 @@ namespace ccat {
 		}
 		CONSTEXPR static auto find(const char_type* ptr, std::size_t count, const char_type& ch) noexcept ->const char_type* {
 			if (ptr == nullptr) return nullptr;
+			if (!std::is_constant_evaluated()) return std::wmemchr(ptr, ch, count);
 			for (std::size_t i{}; i < count; ++i) {
 				if (ptr[i] == ch) return ptr + i;
 			}
@@ -187,4 +201,94 @@ namespace ccat {
 			return static_cast<int_type>(WEOF);
 		}
 	};
+	
+	template<>
+	struct char_traits<char8_t> : char_traits_base<char8_t> {
+		CONSTEXPR static auto compare(const char_type* s1, const char_type* s2, std::size_t count) noexcept ->int {
+			if (std::is_constant_evaluated()) return default_compare(s1, s2, count);
+			else return std::memcmp(s1, s2, count);
+		}
+		CONSTEXPR static auto length(const char_type* s) noexcept ->std::size_t {
+			if (std::is_constant_evaluated()) {
+				std::size_t len{};
+				while (s && *s != u8'\0') {
+					++s;
+					++len;
+				}
+				return len;
+			}
+			else return std::strlen(reinterpret_cast<const char*>(s));
+		}
+		CONSTEXPR static auto find(const char_type* ptr, std::size_t count, const char_type& ch) noexcept ->const char_type* {
+			if (ptr == nullptr) return nullptr;
+			if (!std::is_constant_evaluated()) return static_cast<const char_type*>(std::memchr(ptr, ch, count));
+			for (std::size_t i{}; i < count; ++i) {
+				if (ptr[i] == ch) return ptr + i;
+			}
+			return nullptr;
+		}
+		CONSTEXPR static auto eof() noexcept ->int_type {
+			return static_cast<int_type>(-1);
+		}
+	};
+	
+	template<>
+	struct char_traits<char16_t> : char_traits_base<char16_t> {
+		CONSTEXPR static auto compare(const char_type* s1, const char_type* s2, std::size_t count) noexcept ->int {
+			if (std::is_constant_evaluated()) return default_compare(s1, s2, count);
+			else return detail::wide_compare(s1, s2, count);
+		}
+		CONSTEXPR static auto length(const char_type* s) noexcept ->std::size_t {
+			if (std::is_constant_evaluated()) {
+				std::size_t len{};
+				while (s && *s != u'\0') {
+					++s;
+					++len;
+				}
+				return len;
+			}
+			else return detail::wide_length(s);
+		}
+		CONSTEXPR static auto find(const char_type* ptr, std::size_t count, const char_type& ch) noexcept ->const char_type* {
+			if (ptr == nullptr) return nullptr;
+			if (!std::is_constant_evaluated()) return detail::wide_find(ptr, count, ch);
+			for (std::size_t i{}; i < count; ++i) {
+				if (ptr[i] == ch) return ptr + i;
+			}
+			return nullptr;
+		}
+		CONSTEXPR static auto eof() noexcept ->int_type {
+			return static_cast<int_type>(0xffff);
+		}
+	};
+	
+	template<>
+	struct char_traits<char32_t> : char_traits_base<char32_t> {
+		CONSTEXPR static auto compare(const char_type* s1, const char_type* s2, std::size_t count) noexcept ->int {
+			if (std::is_constant_evaluated()) return default_compare(s1, s2, count);
+			else return detail::wide_compare(s1, s2, count);
+		}
+		CONSTEXPR static auto length(const char_type* s) noexcept ->std::size_t {
+			if (std::is_constant_evaluated()) {
+				std::size_t len{};
+				while (s && *s != U'\0') {
+					++s;
+					++len;
+				}
+				return len;
+			}
+			else return detail::wide_length(s);
+		}
+		CONSTEXPR static auto find(const char_type* ptr, std::size_t count, const char_type& ch) noexcept ->const char_type* {
+			if (ptr == nullptr) return nullptr;
+			if (!std::is_constant_evaluated()) return detail::wide_find(ptr, count, ch);
+			for (std::size_t i{}; i < count; ++i) {
+				if (ptr[i] == ch) return ptr + i;
+			}
+			return nullptr;
+		}
+		CONSTEXPR static auto eof() noexcept ->int_type {
+			return static_cast<int_type>(0xffffffff);
+		}
+	};
 }
\ No newline at end of file
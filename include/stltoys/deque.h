@@ -0,0 +1,753 @@
+#pragma once
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include "detail/config.h"
+#include "detail/iterator.h"
+#include "detail/concepts.h"
+#include "detail/util.h"
+
+namespace ccat::detail {
+	template<typename T>
+	inline constexpr std::size_t deque_block_size = [] { // at least 512 bytes or 16 elements, rounded up to whole cache lines
+		std::size_t count = std::max<std::size_t>(16, 512 / sizeof(T));
+		std::size_t step = cache_line_size / std::gcd(sizeof(T), cache_line_size);
+		return (count + step - 1) / step * step;
+	}();
+
+	template<bool Mutable, typename T, std::size_t BlockSize>
+	class deque_iterator { // a slot of the block map and an offset into that block
+		template<bool Mutable_, typename T_, std::size_t BlockSize_>
+		friend class deque_iterator;
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using value_type = T;
+		using pointer = std::conditional_t<Mutable, value_type*, const value_type*>;
+		using reference = std::conditional_t<Mutable, value_type&, const value_type&>;
+		using difference_type = std::ptrdiff_t;
+		using node_pointer = value_type* const*;
+	public:
+		CONSTEXPR deque_iterator() noexcept = default;
+
+		CONSTEXPR deque_iterator(node_pointer node, difference_type offset) noexcept : node_(node), off_(offset) {}
+
+		template<bool OtherMutable> requires (!Mutable && OtherMutable)
+		CONSTEXPR deque_iterator(const deque_iterator<OtherMutable, value_type, BlockSize>& other) noexcept : node_(other.node_), off_(other.off_) {}
+	public:
+		CONSTEXPR auto operator++ () noexcept -> deque_iterator& {
+			if (++off_ == block_size_) {
+				++node_;
+				off_ = 0;
+			}
+			return *this;
+		}
+
+		CONSTEXPR auto operator++ (int) noexcept -> deque_iterator {
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		CONSTEXPR auto operator-- () noexcept -> deque_iterator& {
+			if (off_ == 0) {
+				--node_;
+				off_ = block_size_;
+			}
+			--off_;
+			return *this;
+		}
+
+		CONSTEXPR auto operator-- (int) noexcept -> deque_iterator {
+			auto tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		CONSTEXPR auto operator+= (difference_type n) noexcept -> deque_iterator& {
+			auto pos = off_ + n;
+			if (pos >= 0) {
+				node_ += pos / block_size_;
+				off_ = pos % block_size_;
+			}
+			else {
+				auto blocks = (-pos - 1) / block_size_ + 1;
+				node_ -= blocks;
+				off_ = pos + blocks * block_size_;
+			}
+			return *this;
+		}
+
+		CONSTEXPR friend auto operator+ (deque_iterator it, difference_type n) noexcept -> deque_iterator {
+			return it += n;
+		}
+
+		CONSTEXPR friend auto operator+ (difference_type n, deque_iterator it) noexcept -> deque_iterator {
+			return it += n;
+		}
+
+		CONSTEXPR auto operator-= (difference_type n) noexcept -> deque_iterator& {
+			return *this += -n;
+		}
+
+		CONSTEXPR auto operator- (difference_type n) const noexcept -> deque_iterator {
+			auto tmp = *this;
+			return tmp -= n;
+		}
+
+		CONSTEXPR auto operator- (deque_iterator other) const noexcept -> difference_type {
+			return (node_ - other.node_) * block_size_ + (off_ - other.off_);
+		}
+
+		NODISCARD CONSTEXPR auto operator[] (difference_type n) const noexcept -> reference {
+			return *(*this + n);
+		}
+
+		NODISCARD CONSTEXPR auto operator* () const noexcept -> reference {
+			return (*node_)[off_];
+		}
+
+		CONSTEXPR auto operator-> () const noexcept -> pointer {
+			return *node_ + off_;
+		}
+
+		friend CONSTEXPR auto operator== (deque_iterator lhs, deque_iterator rhs) noexcept -> bool = default;
+
+		friend CONSTEXPR auto operator<=> (deque_iterator lhs, deque_iterator rhs) noexcept -> std::strong_ordering {
+			if (auto cmp = lhs.node_ <=> rhs.node_; cmp != 0) return cmp;
+			return lhs.off_ <=> rhs.off_;
+		}
+	private:
+		static constexpr difference_type block_size_ = BlockSize;
+	private:
+		node_pointer node_ = nullptr;
+		difference_type off_ = 0;
+	};
+}
+
+namespace ccat {
+	// elements live in fixed-size blocks which never move once allocated; a map of block pointers is recentered or
+	// regrown when either end runs out of slots, and blocks left behind by pops are kept for reuse
+	template<typename T, typename Alloc = std::allocator<T>> requires std::same_as<T, std::remove_cvref_t<T>> && std::same_as<T, typename Alloc::value_type> && concepts::erasable<T, Alloc> && std::is_pointer_v<typename std::allocator_traits<Alloc>::pointer>
+	class deque {
+	public:
+		using value_type = T;
+		using allocator_type = Alloc;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = typename std::allocator_traits<allocator_type>::pointer;
+		using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using iterator = detail::deque_iterator<true, value_type, detail::deque_block_size<value_type>>;
+		using const_iterator = detail::deque_iterator<false, value_type, detail::deque_block_size<value_type>>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		static constexpr size_type block_size = detail::deque_block_size<value_type>; // Cra3z extension
+	public: // ctor and dtor
+
+		CONSTEXPR deque() = default;
+
+		CONSTEXPR explicit deque(const allocator_type& alloc) noexcept: alloc_(alloc) {}
+
+		CONSTEXPR deque(size_type count, const_reference value, const allocator_type& alloc = allocator_type()) : alloc_(alloc) {
+			(void) this->append_n_(detail::repeat_iterator<value_type>{value}, count);
+		}
+
+		CONSTEXPR explicit deque(size_type count, const allocator_type& alloc = allocator_type()) : alloc_(alloc) {
+			this->resize(count);
+		}
+
+		template<std::input_iterator InputIt>
+		CONSTEXPR deque(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : alloc_(alloc) {
+			(void) this->append_range_impl_(std::move(first), std::move(last));
+		}
+
+		CONSTEXPR deque(const deque& other) :
+			alloc_(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
+		{
+			this->append_range(other);
+		}
+
+		CONSTEXPR deque(const deque& other, const allocator_type& alloc) : alloc_(alloc) {
+			this->append_range(other);
+		}
+
+		CONSTEXPR deque(deque&& other) noexcept : alloc_(std::move(other.alloc_)) {
+			this->steal_(other);
+		}
+
+		CONSTEXPR deque(deque&& other, const allocator_type& alloc) : alloc_(alloc) {
+			if (alloc_ == other.alloc_) {
+				this->steal_(other);
+			}
+			else {
+				(void) this->append_n_(std::make_move_iterator(other.begin()), other.size());
+				other.clear();
+			}
+		}
+
+		CONSTEXPR deque(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type()) : alloc_(alloc) {
+			(void) this->append_n_(ilist.begin(), ilist.size());
+		}
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR deque(from_range_t, Range&& rng, const allocator_type& alloc = allocator_type()) : alloc_(alloc) {
+			this->append_range(std::forward<Range>(rng));
+		}
+
+		CONSTEXPR ~deque() {
+			die_();
+		}
+	public:
+
+		CONSTEXPR auto operator= (const deque& other) ->deque& {
+			if (this == std::addressof(other)) [[unlikely]] return *this;
+			if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value) {
+				if (alloc_ != other.alloc_) die_();
+				alloc_ = other.alloc_;
+			}
+			this->assign_range(other);
+			return *this;
+		}
+
+		CONSTEXPR auto operator= (deque&& other) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value || std::allocator_traits<allocator_type>::is_always_equal::value) ->deque& {
+			if (this == std::addressof(other)) [[unlikely]] return *this;
+			if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+				die_();
+				alloc_ = std::move(other.alloc_);
+				this->steal_(other);
+			}
+			else {
+				if (alloc_ == other.alloc_) {
+					die_();
+					this->steal_(other);
+				}
+				else {
+					this->assign_range(std::ranges::subrange{std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())});
+					other.clear();
+				}
+			}
+			return *this;
+		}
+
+		CONSTEXPR auto operator= (std::initializer_list<value_type> ilist) ->deque& {
+			this->assign_range(ilist);
+			return *this;
+		}
+
+		CONSTEXPR auto assign(size_type count, const_reference value) ->void {
+			this->assign_range(std::ranges::subrange{detail::repeat_iterator<value_type>{value}, detail::repeat_iterator<value_type>{value, static_cast<difference_type>(count)}});
+		}
+
+		template<std::input_iterator InputIt>
+		CONSTEXPR auto assign(InputIt first, InputIt last) ->void {
+			this->assign_range(std::ranges::subrange{std::move(first), std::move(last)});
+		}
+
+		CONSTEXPR auto assign(std::initializer_list<value_type> ilist) ->void {
+			this->assign_range(ilist);
+		}
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR auto assign_range(Range&& rng) ->void requires
+			std::assignable_from<T&, std::ranges::range_reference_t<Range>> &&
+			concepts::emplace_constructible_from<value_type, deque, std::ranges::range_reference_t<Range>>
+		{
+			auto it = begin();
+			auto end_ = end();
+			auto rng_it = std::ranges::begin(rng);
+			auto rng_end = std::ranges::end(rng);
+			while (it != end_ && rng_it != rng_end) {
+				*it = *rng_it;
+				++it;
+				++rng_it;
+			}
+			this->erase_back_(static_cast<size_type>(end_ - it));
+			(void) this->append_range_impl_(std::move(rng_it), std::move(rng_end));
+		}
+
+		NODISCARD CONSTEXPR auto begin() noexcept ->iterator {
+			return this->iter_(first_);
+		}
+
+		NODISCARD CONSTEXPR auto begin() const noexcept ->const_iterator {
+			return this->iter_(first_);
+		}
+
+		NODISCARD CONSTEXPR auto cbegin() const noexcept ->const_iterator {
+			return begin();
+		}
+
+		NODISCARD CONSTEXPR auto rbegin() noexcept ->reverse_iterator {
+			return std::make_reverse_iterator(end());
+		}
+
+		NODISCARD CONSTEXPR auto rbegin() const noexcept ->const_reverse_iterator {
+			return std::make_reverse_iterator(end());
+		}
+
+		NODISCARD CONSTEXPR auto crbegin() const noexcept ->const_reverse_iterator {
+			return rbegin();
+		}
+
+		NODISCARD CONSTEXPR auto end() noexcept ->iterator {
+			return this->iter_(first_ + size_);
+		}
+
+		NODISCARD CONSTEXPR auto end() const noexcept ->const_iterator {
+			return this->iter_(first_ + size_);
+		}
+
+		NODISCARD CONSTEXPR auto cend() const noexcept ->const_iterator {
+			return end();
+		}
+
+		NODISCARD CONSTEXPR auto rend() noexcept ->reverse_iterator {
+			return std::make_reverse_iterator(begin());
+		}
+
+		NODISCARD CONSTEXPR auto rend() const noexcept ->const_reverse_iterator {
+			return std::make_reverse_iterator(begin());
+		}
+
+		NODISCARD CONSTEXPR auto crend() const noexcept ->const_reverse_iterator {
+			return rend();
+		}
+
+		NODISCARD CONSTEXPR auto size() const noexcept ->size_type {
+			return size_;
+		}
+
+		NODISCARD CONSTEXPR auto max_size() const noexcept ->size_type {
+			return std::numeric_limits<difference_type>::max();
+		}
+
+		NODISCARD CONSTEXPR auto empty() const noexcept ->bool {
+			return size_ == 0;
+		}
+
+		NODISCARD CONSTEXPR auto operator[] (size_type index) noexcept ->reference {
+			return *this->slot_(first_ + index);
+		}
+
+		NODISCARD CONSTEXPR auto operator[] (size_type index) const noexcept ->const_reference {
+			return *this->slot_(first_ + index);
+		}
+
+		NODISCARD CONSTEXPR auto front() noexcept ->reference {
+			return *this->slot_(first_);
+		}
+
+		NODISCARD CONSTEXPR auto front() const noexcept ->const_reference {
+			return *this->slot_(first_);
+		}
+
+		NODISCARD CONSTEXPR auto back() noexcept ->reference {
+			return *this->slot_(first_ + size_ - 1);
+		}
+
+		NODISCARD CONSTEXPR auto back() const noexcept ->const_reference {
+			return *this->slot_(first_ + size_ - 1);
+		}
+
+		NODISCARD CONSTEXPR auto get_allocator() const noexcept ->allocator_type {
+			return alloc_;
+		}
+
+		NODISCARD CONSTEXPR auto at(size_type index) ->reference {
+			if (index >= size()) throw std::out_of_range{"in `ccat::deque::at`: the parameter `index` is out of range"};
+			return (*this)[index];
+		}
+
+		NODISCARD CONSTEXPR auto at(size_type index) const ->const_reference {
+			if (index >= size()) throw std::out_of_range{"in `ccat::deque::at`: the parameter `index` is out of range"};
+			return (*this)[index];
+		}
+
+		CONSTEXPR auto resize(size_type new_size) ->void requires concepts::default_insertable_into<value_type, deque> {
+			if (new_size <= size_) return this->erase_back_(size_ - new_size);
+			this->reserve_back_(new_size - size_);
+			detail::alloc_uninitialized_default_construct(end(), this->iter_(first_ + new_size), alloc_);
+			size_ = new_size;
+		}
+
+		CONSTEXPR auto resize(size_type new_size, const_reference value) ->void requires concepts::copy_insertable_into<value_type, deque> {
+			if (new_size <= size_) return this->erase_back_(size_ - new_size);
+			(void) this->append_n_(detail::repeat_iterator<value_type>{value}, new_size - size_);
+		}
+
+		CONSTEXPR auto shrink_to_fit() noexcept ->void { // frees the blocks kept for reuse; elements stay where they are
+			auto [used_begin, used_end] = this->used_blocks_();
+			for (size_type i = 0; i < map_size_; ++i) {
+				if ((i < used_begin || i >= used_end) && map_[i]) {
+					std::allocator_traits<allocator_type>::deallocate(alloc_, map_[i], block_size);
+					map_[i] = nullptr;
+				}
+			}
+		}
+
+		CONSTEXPR auto clear() noexcept ->void {
+			detail::alloc_destroy(begin(), end(), alloc_);
+			size_ = 0;
+		}
+
+		CONSTEXPR auto erase(const_iterator pos) ->iterator requires concepts::move_assignable<value_type> {
+			return this->erase(pos, pos + 1);
+		}
+
+		CONSTEXPR auto erase(const_iterator first, const_iterator last) ->iterator requires concepts::move_assignable<value_type> {
+			auto idx = static_cast<size_type>(first - cbegin());
+			auto count = static_cast<size_type>(last - first);
+			if (count == 0) return begin() + idx;
+			if (idx < size_ - idx - count) { // fewer elements in front of the range: shift them towards the back
+				std::move_backward(begin(), begin() + idx, begin() + (idx + count));
+				this->erase_front_(count);
+			}
+			else {
+				std::move(begin() + (idx + count), end(), begin() + idx);
+				this->erase_back_(count);
+			}
+			return begin() + idx;
+		}
+
+		CONSTEXPR auto pop_back() ->void {
+			this->erase_back_(1);
+		}
+
+		CONSTEXPR auto pop_front() ->void {
+			this->erase_front_(1);
+		}
+
+		template<typename... Args> requires concepts::move_assignable<value_type> && concepts::move_insertable_into<value_type, deque> && concepts::emplace_constructible_from<value_type, deque, Args...>
+		CONSTEXPR auto emplace(const_iterator pos, Args&&... args) ->iterator {
+			auto idx = static_cast<size_type>(pos - cbegin());
+			if (idx == 0) {
+				this->emplace_front(std::forward<Args>(args)...);
+				return begin();
+			}
+			if (idx == size_) {
+				this->emplace_back(std::forward<Args>(args)...);
+				return end() - 1;
+			}
+			value_type tmp(std::forward<Args>(args)...);
+			if (idx < size_ / 2) { // shift the front part one slot towards the front
+				this->emplace_front(std::move(front()));
+				std::move(begin() + 2, begin() + (idx + 1), begin() + 1);
+			}
+			else {
+				this->emplace_back(std::move(back()));
+				std::move_backward(begin() + idx, end() - 2, end() - 1);
+			}
+			auto where_ = begin() + idx;
+			*where_ = std::move(tmp);
+			return where_;
+		}
+
+		template<typename... Args> requires concepts::emplace_constructible_from<value_type, deque, Args...>
+		CONSTEXPR auto emplace_back(Args&&... args) ->reference {
+			this->reserve_back_(1);
+			auto slot = this->slot_(first_ + size_);
+			std::allocator_traits<allocator_type>::construct(alloc_, slot, std::forward<Args>(args)...);
+			++size_;
+			return *slot;
+		}
+
+		template<typename... Args> requires concepts::emplace_constructible_from<value_type, deque, Args...>
+		CONSTEXPR auto emplace_front(Args&&... args) ->reference {
+			this->reserve_front_(1);
+			auto slot = this->slot_(first_ - 1);
+			std::allocator_traits<allocator_type>::construct(alloc_, slot, std::forward<Args>(args)...);
+			--first_;
+			++size_;
+			return *slot;
+		}
+
+		CONSTEXPR auto push_back(const value_type& value) ->void requires concepts::copy_insertable_into<value_type, deque> {
+			this->emplace_back(value);
+		}
+
+		CONSTEXPR auto push_back(value_type&& value) ->void requires concepts::move_insertable_into<value_type, deque> {
+			this->emplace_back(std::move(value));
+		}
+
+		CONSTEXPR auto push_front(const value_type& value) ->void requires concepts::copy_insertable_into<value_type, deque> {
+			this->emplace_front(value);
+		}
+
+		CONSTEXPR auto push_front(value_type&& value) ->void requires concepts::move_insertable_into<value_type, deque> {
+			this->emplace_front(std::move(value));
+		}
+
+		CONSTEXPR auto insert(const_iterator pos, const_reference value) ->iterator requires concepts::copy_assignable<value_type> && concepts::copy_insertable_into<value_type, deque> {
+			return this->emplace(pos, value);
+		}
+
+		CONSTEXPR auto insert(const_iterator pos, value_type&& value) ->iterator requires concepts::move_assignable<value_type> && concepts::move_insertable_into<value_type, deque> {
+			return this->emplace(pos, std::move(value));
+		}
+
+		CONSTEXPR auto insert(const_iterator pos, size_type count, const_reference value) ->iterator requires concepts::copy_assignable<value_type> && concepts::copy_insertable_into<value_type, deque> {
+			auto idx = static_cast<size_type>(pos - cbegin());
+			if (count == 0) return begin() + idx;
+			value_type tmp(value); // `value` may be an element which the rotation moves
+			return this->insert_n_(idx, count, detail::repeat_iterator<value_type>{tmp});
+		}
+
+		template<std::input_iterator InputIt> requires concepts::emplace_constructible_from<value_type, deque, std::iter_value_t<InputIt>> && std::movable<value_type> && concepts::move_insertable_into<value_type, deque>
+		CONSTEXPR auto insert(const_iterator pos, InputIt first, InputIt last) ->iterator {
+			return this->insert_range_impl_(static_cast<size_type>(pos - cbegin()), std::move(first), std::move(last));
+		}
+
+		CONSTEXPR auto insert(const_iterator pos, std::initializer_list<value_type> ilist) ->iterator requires std::movable<value_type> && concepts::move_insertable_into<value_type, deque> {
+			return this->insert_n_(static_cast<size_type>(pos - cbegin()), ilist.size(), ilist.begin());
+		}
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR auto insert_range(const_iterator pos, Range&& rng) ->iterator requires concepts::emplace_constructible_from<value_type, deque, std::ranges::range_reference_t<Range>> && std::movable<value_type> && concepts::move_insertable_into<value_type, deque> {
+			if constexpr (std::ranges::sized_range<Range>) {
+				return this->insert_n_(static_cast<size_type>(pos - cbegin()), std::ranges::size(rng), std::ranges::begin(rng));
+			}
+			else {
+				return this->insert_range_impl_(static_cast<size_type>(pos - cbegin()), std::ranges::begin(rng), std::ranges::end(rng));
+			}
+		}
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR auto append_range(Range&& rng) ->void requires concepts::emplace_constructible_from<value_type, deque, std::ranges::range_reference_t<Range>> {
+			if constexpr (std::ranges::sized_range<Range>) {
+				(void) this->append_n_(std::ranges::begin(rng), std::ranges::size(rng));
+			}
+			else {
+				(void) this->append_range_impl_(std::ranges::begin(rng), std::ranges::end(rng));
+			}
+		}
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR auto prepend_range(Range&& rng) ->void requires concepts::emplace_constructible_from<value_type, deque, std::ranges::range_reference_t<Range>> && std::movable<value_type> && concepts::move_insertable_into<value_type, deque> {
+			(void) this->insert_range(cbegin(), std::forward<Range>(rng));
+		}
+
+		CONSTEXPR auto swap(deque& other) noexcept ->void { // undefined if propagate_on_container_swap::value is false and this->alloc_ not equal to other.alloc_
+			if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+				std::ranges::swap(alloc_, other.alloc_);
+			}
+			std::ranges::swap(map_, other.map_);
+			std::ranges::swap(map_size_, other.map_size_);
+			std::ranges::swap(first_, other.first_);
+			std::ranges::swap(size_, other.size_);
+		}
+
+		CONSTEXPR friend auto swap(deque& lhs, deque& rhs) noexcept ->void {
+			lhs.swap(rhs);
+		}
+
+		CONSTEXPR friend auto operator== (const deque& lhs, const deque& rhs) noexcept ->bool {
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+
+		CONSTEXPR friend auto operator<=> (const deque& lhs, const deque& rhs) noexcept {
+			return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+	private:
+		using map_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<pointer>;
+
+		NODISCARD CONSTEXPR auto slot_(size_type global) const noexcept ->pointer { // `global` counts slots from the first block of the map
+			return map_[global / block_size] + global % block_size;
+		}
+
+		NODISCARD CONSTEXPR auto iter_(size_type global) const noexcept ->iterator {
+			return {map_ + global / block_size, static_cast<difference_type>(global % block_size)};
+		}
+
+		NODISCARD CONSTEXPR auto used_blocks_() const noexcept ->std::pair<size_type, size_type> {
+			auto used_begin = first_ / block_size;
+			return {used_begin, size_ == 0 ? used_begin : (first_ + size_ - 1) / block_size + 1};
+		}
+
+		CONSTEXPR auto steal_(deque& other) noexcept ->void {
+			map_ = std::exchange(other.map_, {});
+			map_size_ = std::exchange(other.map_size_, 0);
+			first_ = std::exchange(other.first_, 0);
+			size_ = std::exchange(other.size_, 0);
+		}
+
+		CONSTEXPR auto die_() noexcept ->void {
+			clear();
+			for (size_type i = 0; i < map_size_; ++i) {
+				if (map_[i]) std::allocator_traits<allocator_type>::deallocate(alloc_, map_[i], block_size);
+			}
+			if (map_) {
+				map_allocator_type map_alloc(alloc_);
+				std::allocator_traits<map_allocator_type>::deallocate(map_alloc, map_, map_size_);
+			}
+			map_ = nullptr;
+			map_size_ = 0;
+			first_ = 0;
+		}
+
+		CONSTEXPR auto erase_back_(size_type count) noexcept ->void {
+			detail::alloc_destroy(end() - static_cast<difference_type>(count), end(), alloc_);
+			size_ -= count;
+		}
+
+		CONSTEXPR auto erase_front_(size_type count) noexcept ->void {
+			detail::alloc_destroy(begin(), begin() + static_cast<difference_type>(count), alloc_);
+			first_ += count;
+			size_ -= count;
+		}
+
+		CONSTEXPR auto allocate_blocks_(size_type first_block, size_type last_block) ->void {
+			for (; first_block < last_block; ++first_block) {
+				if (!map_[first_block]) map_[first_block] = std::allocator_traits<allocator_type>::allocate(alloc_, block_size);
+			}
+		}
+
+		CONSTEXPR auto reserve_back_(size_type count) ->void { // makes room for `count` more elements after the back
+			if (count == 0) return;
+			auto last_block = (first_ + size_ + count - 1) / block_size;
+			if (last_block >= map_size_) {
+				this->remap_(0, last_block + 1 - this->used_blocks_().second);
+				last_block = (first_ + size_ + count - 1) / block_size;
+			}
+			this->allocate_blocks_((first_ + size_) / block_size, last_block + 1);
+		}
+
+		CONSTEXPR auto reserve_front_(size_type count) ->void { // makes room for `count` more elements before the front
+			if (count == 0) return;
+			if (count > first_) {
+				auto offset = first_ % block_size;
+				this->remap_((count - offset + block_size - 1) / block_size, 0);
+			}
+			this->allocate_blocks_((first_ - count) / block_size, (first_ + block_size - 1) / block_size);
+		}
+
+		// leaves at least `front_blocks` free slots before the used blocks and `back_blocks` after them,
+		// by rotating the map when it is at most half full and by moving the block pointers into a larger map otherwise
+		CONSTEXPR auto remap_(size_type front_blocks, size_type back_blocks) ->void {
+			auto [used_begin, used_end] = this->used_blocks_();
+			auto used = used_end - used_begin;
+			auto needed = front_blocks + used + back_blocks;
+			auto offset = first_ % block_size;
+			if (map_size_ >= 2 * needed) {
+				auto new_begin = front_blocks + (map_size_ - needed) / 2;
+				if (new_begin < used_begin) std::rotate(map_, map_ + (used_begin - new_begin), map_ + map_size_);
+				else if (new_begin > used_begin) std::rotate(map_, map_ + (map_size_ - (new_begin - used_begin)), map_ + map_size_);
+				first_ = new_begin * block_size + offset;
+				return;
+			}
+			auto new_map_size = std::max<size_type>(2 * needed, 8);
+			auto new_begin = front_blocks + (new_map_size - needed) / 2;
+			map_allocator_type map_alloc(alloc_);
+			pointer* new_map = std::allocator_traits<map_allocator_type>::allocate(map_alloc, new_map_size);
+			for (size_type i = 0; i < new_map_size; ++i) {
+				std::construct_at(new_map + i, nullptr);
+			}
+			for (size_type i = used_begin; i < used_end; ++i) {
+				new_map[new_begin + (i - used_begin)] = map_[i];
+			}
+			auto spare = new_begin + used; // the blocks kept for reuse go after the used ones, wrapping around to the front
+			for (size_type i = 0; i < map_size_; ++i) {
+				if ((i >= used_begin && i < used_end) || !map_[i]) continue;
+				if (spare == new_map_size) spare = 0;
+				new_map[spare++] = map_[i];
+			}
+			if (map_) std::allocator_traits<map_allocator_type>::deallocate(map_alloc, map_, map_size_);
+			map_ = new_map;
+			map_size_ = new_map_size;
+			first_ = new_begin * block_size + offset;
+		}
+
+		template<typename InputIt, typename Sentinel>
+		CONSTEXPR auto append_range_impl_(InputIt first, Sentinel last) ->iterator {
+			if constexpr (std::forward_iterator<InputIt> || std::sized_sentinel_for<Sentinel, InputIt>) {
+				auto count = static_cast<size_type>(std::ranges::distance(first, last));
+				return this->append_n_(std::move(first), count);
+			}
+			else {
+				auto old_size_ = size();
+				for (; first != last; ++first) {
+					this->emplace_back(*first);
+				}
+				return begin() + old_size_;
+			}
+		}
+
+		template<typename InputIt>
+		CONSTEXPR auto append_n_(InputIt first, size_type count) ->iterator {
+			auto old_size_ = size();
+			this->reserve_back_(count);
+			(void) detail::alloc_uninitialized_copy_n(std::move(first), count, end(), alloc_);
+			size_ += count;
+			return begin() + old_size_;
+		}
+
+		template<typename InputIt>
+		CONSTEXPR auto prepend_n_(InputIt first, size_type count) ->void {
+			this->reserve_front_(count);
+			(void) detail::alloc_uninitialized_copy_n(std::move(first), count, this->iter_(first_ - count), alloc_);
+			first_ -= count;
+			size_ += count;
+		}
+
+		template<typename InputIt, typename Sentinel>
+		CONSTEXPR auto insert_range_impl_(size_type idx, InputIt first, Sentinel last) ->iterator {
+			if (idx == size()) return this->append_range_impl_(std::move(first), std::move(last));
+			if constexpr (std::forward_iterator<InputIt> || std::sized_sentinel_for<Sentinel, InputIt>) {
+				auto count = static_cast<size_type>(std::ranges::distance(first, last));
+				return this->insert_n_(idx, count, std::move(first));
+			}
+			else { // single pass: buffer first so that the elements are rotated only once
+				deque buffer_(alloc_);
+				(void) buffer_.append_range_impl_(std::move(first), std::move(last));
+				return this->insert_n_(idx, buffer_.size(), std::make_move_iterator(buffer_.begin()));
+			}
+		}
+
+		template<typename InputIt>
+		CONSTEXPR auto insert_n_(size_type idx, size_type count, InputIt first) ->iterator { // builds the new elements at the nearer end, then rotates them into place
+			if (idx < size_ / 2) {
+				this->prepend_n_(std::move(first), count);
+				std::rotate(begin(), begin() + count, begin() + (count + idx));
+			}
+			else {
+				auto old_size_ = size_;
+				(void) this->append_n_(std::move(first), count);
+				std::rotate(begin() + idx, begin() + old_size_, end());
+			}
+			return begin() + idx;
+		}
+	private:
+		pointer* map_{};
+		size_type map_size_{};
+		size_type first_{};
+		size_type size_{};
+		allocator_type alloc_;
+	};
+
+	template<typename T, typename Alloc, typename U> requires std::equality_comparable_with<T, U>
+	CONSTEXPR auto erase(deque<T, Alloc>& c, const U& value) ->typename deque<T, Alloc>::size_type {
+		auto it = std::remove(c.begin(), c.end(), value);
+		auto r = c.end() - it;
+		c.erase(it, c.end());
+		return r;
+	}
+
+	template<typename T, typename Alloc, typename Pred> requires std::predicate<Pred, T&>
+	CONSTEXPR auto erase_if(deque<T, Alloc>& c, Pred pred) ->typename deque<T, Alloc>::size_type {
+		auto it = std::remove_if(c.begin(), c.end(), pred);
+		auto r = c.end() - it;
+		c.erase(it, c.end());
+		return r;
+	}
+
+	template<std::input_iterator InputIt, typename Alloc = std::allocator<typename std::iterator_traits<InputIt>::value_type>>
+	deque(InputIt, InputIt, Alloc = Alloc()) -> deque<typename std::iterator_traits<InputIt>::value_type, Alloc>;
+
+	template<std::ranges::input_range Range, typename Alloc = std::allocator<std::ranges::range_value_t<Range>> >
+	deque(from_range_t, Range&&, Alloc = Alloc()) -> deque<std::ranges::range_value_t<Range>, Alloc>;
+}
\ No newline at end of file
@@ -1,4 +1,7 @@
 #pragma once
+#include <bit>
+#include <climits>
+#include <limits>
 #include "../basic_string_view.h"
 #include "../array.h"
 
@@ -35,7 +38,7 @@ namespace ccat {
 namespace ccat::detail {
 	
 	template<typename CharT, typename Traits, typename AllocType>
-	class basic_string_base {
+	class basic_string_base<CharT, Traits, AllocType, string_layout::pointers> {
 	protected:
 		using view_type = ccat::basic_string_view<CharT, Traits>;
 		using slice_type = ccat::basic_string_slice<CharT, Traits>;
@@ -66,14 +69,18 @@ namespace ccat::detail {
 		template<typename Alloc> requires std::same_as<std::remove_cvref_t<Alloc>, allocator_type>
 		CONSTEXPR basic_string_base(Alloc&& alloc, view_type v) : basic_string_base(std::forward<Alloc>(alloc), v.data(), v.size()) {}
 
-		CONSTEXPR basic_string_base(const basic_string_base& other) : basic_string_base(other.alloc_, other.slice_) {}
+		CONSTEXPR basic_string_base(const basic_string_base& other) : basic_string_base(allocator_traits::select_on_container_copy_construction(other.alloc_), other.slice_) {}
 		
 		CONSTEXPR basic_string_base(basic_string_base&& other) noexcept : alloc_(std::move(other.alloc_)), sso(std::move(other.sso)) {
 			swap_slice(other);
 		}
 		
-		CONSTEXPR basic_string_base(const allocator_type& alloc, basic_string_base&& other) : alloc_(alloc), sso(std::move(other.sso))  {
-			swap_slice(other);
+		CONSTEXPR basic_string_base(const allocator_type& alloc, basic_string_base&& other) : alloc_(alloc) {
+			if (allocator_traits::is_always_equal::value || alloc_ == other.alloc_) {
+				sso = std::move(other.sso);
+				swap_slice(other);
+			}
+			else set_ptrs(other.slice_.beg_, other.size()); // the buffer belongs to another allocator
 		}
 		
 		CONSTEXPR ~basic_string_base() noexcept {
@@ -81,8 +88,10 @@ namespace ccat::detail {
 		}
 		
 		CONSTEXPR auto operator= (const basic_string_base& other) ->basic_string_base& {
-			basic_string_base tmp = other; // copy and swap
-			swap(tmp);
+			if (this == std::addressof(other)) return *this;
+			basic_string_base tmp(allocator_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : alloc_, other.slice_); // copy and swap
+			std::ranges::swap(alloc_, tmp.alloc_);
+			swap_storage(tmp);
 			return *this;
 		}
 		
@@ -90,8 +99,16 @@ namespace ccat::detail {
 			std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
 		    std::allocator_traits<allocator_type>::is_always_equal::value
 		) ->basic_string_base& {
+			if constexpr (!allocator_traits::propagate_on_container_move_assignment::value && !allocator_traits::is_always_equal::value) {
+				if (alloc_ != other.alloc_) { // keep our allocator and copy the characters into it
+					basic_string_base tmp(alloc_, other.slice_);
+					swap_storage(tmp);
+					return *this;
+				}
+			}
 			basic_string_base tmp = std::move(other);
-			swap(other);
+			std::ranges::swap(alloc_, tmp.alloc_);
+			swap_storage(tmp);
 			return *this;
 		}
 	public:
@@ -122,12 +139,11 @@ namespace ccat::detail {
 		}
 		
 		CONSTEXPR auto swap(basic_string_base& other) noexcept(
-			std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
+			std::allocator_traits<allocator_type>::propagate_on_container_swap::value ||
 			std::allocator_traits<allocator_type>::is_always_equal::value
-		) ->void {
-			std::ranges::swap(alloc_, other.alloc_);
-			std::ranges::swap(sso, other.sso);
-			swap_slice(other);
+		) ->void { // undefined if the allocators do not propagate on swap and are not equal
+			if constexpr (allocator_traits::propagate_on_container_swap::value) std::ranges::swap(alloc_, other.alloc_);
+			swap_storage(other);
 		}
 		
 	protected:
@@ -167,7 +183,7 @@ namespace ccat::detail {
 			slice_.beg_ = init_size <= sso_size ? sso.data() : allocate(init_cap);
 			slice_.end_ = slice_.beg_ + init_size;
 			cap_ = slice_.beg_ + init_cap;
-			for (size_type i{}; i < init_size; ++i) traits_type::assign(slice_[i], c);
+			traits_type::assign(slice_.beg_, init_size, c);
 			null_terminated();
 		}
 		
@@ -176,7 +192,7 @@ namespace ccat::detail {
 			slice_.beg_ = init_size <= sso_size ? sso.data() : allocate(init_cap);
 			slice_.end_ = slice_.beg_ + init_size;
 			cap_ = slice_.beg_ + init_cap;
-			for (size_type i{}; i < init_size; ++i) traits_type::assign(slice_[i], s[i]);
+			traits_type::copy(slice_.beg_, s, init_size);
 			null_terminated();
 		}
 		
@@ -188,6 +204,35 @@ namespace ccat::detail {
 			*slice_.end_ = null_char;
 		}
 		
+		NODISCARD CONSTEXPR auto begin_ptr() const noexcept ->pointer {
+			return slice_.beg_;
+		}
+		
+		NODISCARD CONSTEXPR auto as_slice() const noexcept ->slice_type {
+			return slice_;
+		}
+		
+		CONSTEXPR auto set_size(size_type new_size) noexcept ->void {
+			slice_.end_ = slice_.beg_ + new_size;
+		}
+		
+		template<typename Fill>
+		CONSTEXPR auto reallocate(size_type new_cap, size_type new_size, Fill fill) ->pointer { // `fill(new_space, old_space)` moves the characters over; returns the new characters
+			auto new_space = allocate(new_cap);
+			fill(new_space, static_cast<const_pointer>(slice_.beg_));
+			deallocate();
+			slice_.beg_ = new_space;
+			slice_.end_ = new_space + new_size;
+			cap_ = new_space + new_cap;
+			null_terminated();
+			return new_space;
+		}
+		
+		CONSTEXPR auto swap_storage(basic_string_base& other) noexcept ->void { // the characters only, never the allocators
+			std::ranges::swap(sso, other.sso);
+			swap_slice(other);
+		}
+		
 		CONSTEXPR auto swap_slice(basic_string_base& other) noexcept ->void {
 			auto size1 = size();
 			auto cap1 = capacity();
@@ -222,4 +267,242 @@ namespace ccat::detail {
 		slice_type slice_{sso.data(), 0};
 		pointer cap_{&sso.back()};
 	};
+	
+	template<typename CharT, typename Traits, typename AllocType>
+	class basic_string_base<CharT, Traits, AllocType, string_layout::compact> {
+		// A long string keeps {pointer, size, capacity}; a short one keeps its characters in the same bytes. The last
+		// byte of the representation tells them apart: a short string stores its size there, a long one has the top
+		// bit set, which the capacity word leaves free. Constant evaluation cannot inspect bytes, so it always goes long.
+	protected:
+		using view_type = ccat::basic_string_view<CharT, Traits>;
+		using slice_type = ccat::basic_string_slice<CharT, Traits>;
+		using allocator_traits = std::allocator_traits<AllocType>;
+		using value_type = CharT;
+		using traits_type = Traits;
+		using allocator_type = AllocType;
+		using size_type = typename std::allocator_traits<allocator_type>::size_type;
+		using difference_type = typename std::allocator_traits<allocator_type>::difference_type;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+	private:
+		struct long_rep {
+			pointer ptr;
+			size_type size;
+			size_type cap_word; // the capacity, with the top bit of the representation's last byte set
+		};
+		
+		struct short_rep {
+			value_type buf[sizeof(long_rep) / sizeof(value_type)];
+		};
+		
+		union rep {
+			short_rep s;
+			long_rep l;
+		};
+		
+		static_assert(sizeof(long_rep) % sizeof(value_type) == 0 && sizeof(short_rep) == sizeof(long_rep));
+		
+		static constexpr unsigned char long_flag = 0x80;
+		static constexpr int tag_shift = std::endian::native == std::endian::little ? std::numeric_limits<size_type>::digits - CHAR_BIT : 0;
+	protected:
+		CONSTEXPR basic_string_base() {
+			init(0);
+			null_terminated();
+		}
+		
+		template<typename Alloc> requires std::same_as<std::remove_cvref_t<Alloc>, allocator_type>
+		CONSTEXPR basic_string_base(Alloc&& alloc) : alloc_(std::forward<Alloc>(alloc)) {
+			init(0);
+			null_terminated();
+		}
+		
+		template<typename Alloc> requires std::same_as<std::remove_cvref_t<Alloc>, allocator_type>
+		CONSTEXPR basic_string_base(Alloc&& alloc, size_type init_size, value_type c = null_char) : alloc_(std::forward<Alloc>(alloc)) {
+			auto p = init(init_size);
+			traits_type::assign(p, init_size, c);
+			p[init_size] = null_char;
+		}
+		
+		template<typename Alloc> requires std::same_as<std::remove_cvref_t<Alloc>, allocator_type>
+		CONSTEXPR basic_string_base(Alloc&& alloc, const_pointer s, size_type init_size) : alloc_(std::forward<Alloc>(alloc)) {
+			auto p = init(init_size);
+			traits_type::copy(p, s, init_size);
+			p[init_size] = null_char;
+		}
+		
+		template<typename Alloc> requires std::same_as<std::remove_cvref_t<Alloc>, allocator_type>
+		CONSTEXPR basic_string_base(Alloc&& alloc, view_type v) : basic_string_base(std::forward<Alloc>(alloc), v.data(), v.size()) {}
+		
+		CONSTEXPR basic_string_base(const basic_string_base& other) : basic_string_base(allocator_traits::select_on_container_copy_construction(other.alloc_), other.as_slice()) {}
+		
+		CONSTEXPR basic_string_base(basic_string_base&& other) noexcept : alloc_(std::move(other.alloc_)), rep_(other.rep_) {
+			other.reset();
+		}
+		
+		CONSTEXPR basic_string_base(const allocator_type& alloc, basic_string_base&& other) : alloc_(alloc) {
+			if (allocator_traits::is_always_equal::value || alloc_ == other.alloc_) {
+				rep_ = other.rep_;
+				other.reset();
+			}
+			else { // the buffer belongs to another allocator
+				auto p = init(other.size());
+				traits_type::copy(p, other.begin_ptr(), other.size());
+				p[other.size()] = null_char;
+			}
+		}
+		
+		CONSTEXPR ~basic_string_base() noexcept {
+			deallocate();
+		}
+		
+		CONSTEXPR auto operator= (const basic_string_base& other) ->basic_string_base& {
+			if (this == std::addressof(other)) return *this;
+			basic_string_base tmp(allocator_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : alloc_, other.as_slice()); // copy and swap
+			std::ranges::swap(alloc_, tmp.alloc_);
+			swap_storage(tmp);
+			return *this;
+		}
+		
+		CONSTEXPR auto operator= (basic_string_base&& other) noexcept(
+			std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
+			std::allocator_traits<allocator_type>::is_always_equal::value
+		) ->basic_string_base& {
+			if constexpr (!allocator_traits::propagate_on_container_move_assignment::value && !allocator_traits::is_always_equal::value) {
+				if (alloc_ != other.alloc_) { // keep our allocator and copy the characters into it
+					basic_string_base tmp(alloc_, other.as_slice());
+					swap_storage(tmp);
+					return *this;
+				}
+			}
+			basic_string_base tmp = std::move(other);
+			std::ranges::swap(alloc_, tmp.alloc_);
+			swap_storage(tmp);
+			return *this;
+		}
+	public:
+		NODISCARD CONSTEXPR auto size() const noexcept ->size_type {
+			return is_long() ? rep_.l.size : tag();
+		}
+		
+		NODISCARD CONSTEXPR auto length() const noexcept ->size_type {
+			return size();
+		}
+		
+		NODISCARD CONSTEXPR auto empty() const noexcept ->bool {
+			return size() == 0;
+		}
+		
+		NODISCARD CONSTEXPR auto max_size() const noexcept ->size_type {
+			return std::min(as_slice().max_size(), (size_type{1} << (std::numeric_limits<size_type>::digits - CHAR_BIT)) - 2);
+		}
+		
+		NODISCARD CONSTEXPR auto capacity() const noexcept ->size_type {
+			if (!is_long()) return sso_size;
+			if constexpr (tag_shift == 0) return rep_.l.cap_word >> CHAR_BIT;
+			else return rep_.l.cap_word & ~(size_type{0xff} << tag_shift);
+		}
+		
+		CONSTEXPR auto clear() noexcept ->void {
+			set_size(0);
+			null_terminated();
+		}
+		
+		CONSTEXPR auto swap(basic_string_base& other) noexcept(
+			std::allocator_traits<allocator_type>::propagate_on_container_swap::value ||
+			std::allocator_traits<allocator_type>::is_always_equal::value
+		) ->void { // undefined if the allocators do not propagate on swap and are not equal
+			if constexpr (allocator_traits::propagate_on_container_swap::value) std::ranges::swap(alloc_, other.alloc_);
+			swap_storage(other);
+		}
+		
+	protected:
+		CONSTEXPR auto swap_storage(basic_string_base& other) noexcept ->void { // the characters only, never the allocators
+			std::ranges::swap(rep_, other.rep_); // neither representation points into itself
+		}
+		
+		NODISCARD CONSTEXPR auto begin_ptr() const noexcept ->pointer {
+			return is_long() ? rep_.l.ptr : const_cast<pointer>(rep_.s.buf);
+		}
+		
+		NODISCARD CONSTEXPR auto as_slice() const noexcept ->slice_type {
+			return slice_type{begin_ptr(), size()};
+		}
+		
+		CONSTEXPR auto set_size(size_type new_size) noexcept ->void {
+			if (is_long()) rep_.l.size = new_size;
+			else set_tag(static_cast<unsigned char>(new_size));
+		}
+		
+		CONSTEXPR auto null_terminated() noexcept ->void {
+			begin_ptr()[size()] = null_char;
+		}
+		
+		template<typename Fill>
+		CONSTEXPR auto reallocate(size_type new_cap, size_type new_size, Fill fill) ->pointer { // `fill(new_space, old_space)` moves the characters over; returns the new characters
+			auto old_space = static_cast<const_pointer>(begin_ptr());
+			if (fits_inline(new_cap)) { // a long string shrinking back
+				short_rep tmp{};
+				fill(tmp.buf, old_space);
+				deallocate();
+				rep_.s = tmp;
+				set_tag(static_cast<unsigned char>(new_size));
+				rep_.s.buf[new_size] = null_char;
+				return rep_.s.buf;
+			}
+			auto new_space = allocator_traits::allocate(alloc_, new_cap + 1);
+			fill(new_space, old_space);
+			deallocate();
+			rep_.l = long_rep{new_space, new_size, encode_cap(new_cap)};
+			new_space[new_size] = null_char;
+			return new_space;
+		}
+	private:
+		NODISCARD static CONSTEXPR auto fits_inline(size_type n) noexcept ->bool {
+			return !std::is_constant_evaluated() && n <= sso_size;
+		}
+		
+		NODISCARD static CONSTEXPR auto encode_cap(size_type cap) noexcept ->size_type {
+			if constexpr (tag_shift == 0) return (cap << CHAR_BIT) | long_flag;
+			else return cap | (size_type{long_flag} << tag_shift);
+		}
+		
+		NODISCARD CONSTEXPR auto is_long() const noexcept ->bool {
+			if (std::is_constant_evaluated()) return true;
+			else return (tag() & long_flag) != 0;
+		}
+		
+		NODISCARD auto tag() const noexcept ->unsigned char {
+			return reinterpret_cast<const unsigned char*>(&rep_)[sizeof(rep) - 1];
+		}
+		
+		auto set_tag(unsigned char t) noexcept ->void {
+			reinterpret_cast<unsigned char*>(&rep_)[sizeof(rep) - 1] = t;
+		}
+		
+		CONSTEXPR auto init(size_type init_size) ->pointer { // room for `init_size` characters, which the caller writes through the result
+			if (fits_inline(init_size)) {
+				set_tag(static_cast<unsigned char>(init_size));
+				return rep_.s.buf;
+			}
+			auto p = allocator_traits::allocate(alloc_, init_size + 1);
+			rep_.l = long_rep{p, init_size, encode_cap(init_size)};
+			return p;
+		}
+		
+		CONSTEXPR auto reset() ->void { // back to empty after the representation has been taken
+			if (std::is_constant_evaluated()) init(0);
+			else rep_.s = short_rep{};
+			null_terminated();
+		}
+		
+		CONSTEXPR auto deallocate() noexcept ->void {
+			if (is_long()) allocator_traits::deallocate(alloc_, rep_.l.ptr, capacity() + 1);
+		}
+	protected:
+		static constexpr value_type null_char = static_cast<value_type>(0);
+		static constexpr size_type sso_size = sizeof(short_rep) / sizeof(value_type) - 2; // the last element holds the tag
+	protected:
+		[[no_unique_address]] mutable allocator_type alloc_{};
+		rep rep_{};
+	};
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include "config.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ccat::detail {
+	// SSE2 scans and fills behind `char_traits<char16_t>` and `char_traits<char32_t>`, for which the C library has no
+	// `memchr` or `memset` counterpart. Scans compare 16 bytes per step and turn the byte mask of the first hit into an
+	// element index.
+	template<typename CharT>
+	concept scannable_wide_char = sizeof(CharT) == 2 || sizeof(CharT) == 4;
+
+#if defined(__SSE2__)
+	template<scannable_wide_char CharT>
+	auto eq_mask(__m128i a, __m128i b) noexcept ->std::uint32_t { // two or four bits per element
+		if constexpr (sizeof(CharT) == 2) return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b)));
+		else return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi32(a, b)));
+	}
+
+	template<scannable_wide_char CharT>
+	auto splat(CharT ch) noexcept ->__m128i {
+		if constexpr (sizeof(CharT) == 2) return _mm_set1_epi16(static_cast<short>(ch));
+		else return _mm_set1_epi32(static_cast<int>(ch));
+	}
+#endif
+
+	template<scannable_wide_char CharT>
+	auto wide_find(const CharT* ptr, std::size_t count, CharT ch) noexcept ->const CharT* {
+		std::size_t i = 0;
+#if defined(__SSE2__)
+		constexpr std::size_t step = 16 / sizeof(CharT);
+		auto needle = splat(ch);
+		for (; i + step <= count; i += step) {
+			if (auto mask = eq_mask<CharT>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i)), needle)) {
+				return ptr + i + std::countr_zero(mask) / sizeof(CharT);
+			}
+		}
+#endif
+		for (; i < count; ++i) {
+			if (ptr[i] == ch) return ptr + i;
+		}
+		return nullptr;
+	}
+
+	template<scannable_wide_char CharT>
+	auto wide_compare(const CharT* s1, const CharT* s2, std::size_t count) noexcept ->int {
+		std::size_t i = 0;
+#if defined(__SSE2__)
+		constexpr std::size_t step = 16 / sizeof(CharT);
+		for (; i + step <= count; i += step) {
+			auto mask = eq_mask<CharT>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s2 + i)));
+			if (mask != 0xffff) {
+				i += std::countr_one(mask) / sizeof(CharT);
+				break;
+			}
+		}
+#endif
+		for (; i < count; ++i) {
+			if (s1[i] != s2[i]) return s1[i] < s2[i] ? -1 : 1;
+		}
+		return 0;
+	}
+
+	template<scannable_wide_char CharT>
+	NO_SANITIZE_ADDRESS auto wide_length(const CharT* s) noexcept ->std::size_t {
+#if defined(__SSE2__)
+		// Aligned loads never cross into the next page, so reading the whole block around the terminator is safe.
+		auto offset = reinterpret_cast<std::uintptr_t>(s) & 15;
+		auto block = reinterpret_cast<const __m128i*>(reinterpret_cast<const char*>(s) - offset);
+		auto zero = _mm_setzero_si128();
+		auto mask = eq_mask<CharT>(_mm_load_si128(block), zero) >> offset << offset;
+		while (mask == 0) mask = eq_mask<CharT>(_mm_load_si128(++block), zero);
+		return static_cast<std::size_t>(reinterpret_cast<const char*>(block) + std::countr_zero(mask) - reinterpret_cast<const char*>(s)) / sizeof(CharT);
+#else
+		std::size_t len = 0;
+		while (s[len] != CharT{}) ++len;
+		return len;
+#endif
+	}
+
+	template<scannable_wide_char CharT>
+	auto wide_fill(CharT* ptr, std::size_t count, CharT ch) noexcept ->void {
+		std::size_t i = 0;
+#if defined(__SSE2__)
+		constexpr std::size_t step = 16 / sizeof(CharT);
+		auto value = splat(ch);
+		for (; i + step <= count; i += step) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(ptr + i), value);
+		}
+#endif
+		for (; i < count; ++i) ptr[i] = ch;
+	}
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <concepts>
 #include <type_traits>
 #include <ranges>
+#include "util.h"
 
 namespace ccat::concepts {
 	template<typename T>
@@ -71,6 +72,18 @@ namespace ccat::concepts {
 			std::is_nothrow_move_constructible_v<T>
 		);
 
+	template<typename T, typename Container>
+	concept trivially_relocatable_into = is_trivially_relocatable_v<T> &&
+		!detail::alloc_move_insertable<T, typename Container::allocator_type> &&
+		!detail::alloc_erasable<T, typename Container::allocator_type>;
+
+	template<typename T, typename Container> // the allocator can grow a buffer of `T` in place, or move its bytes itself
+	concept reallocatable_into = trivially_relocatable_into<T, Container> &&
+		requires (typename Container::allocator_type& alloc, typename std::allocator_traits<typename Container::allocator_type>::pointer p, typename std::allocator_traits<typename Container::allocator_type>::size_type n) {
+			{ alloc.reallocate(p, n, n).ptr } -> std::convertible_to<decltype(p)>;
+			{ alloc.reallocate(p, n, n).count } -> std::convertible_to<decltype(n)>;
+		};
+
 	template<typename T, typename Container, typename... Args>
 	concept emplace_constructible_from = detail::alloc_emplace_constructible<T, typename Container::allocator_type, Args...> || std::constructible_from<T, Args...>;
 
@@ -3,4 +3,10 @@
 
 #define CONSTEXPR constexpr
 #define CONSTEVAL consteval
-#define NODISCARD [[nodiscard]]
\ No newline at end of file
+#define NODISCARD [[nodiscard]]
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define NO_SANITIZE_ADDRESS
+#endif
\ No newline at end of file
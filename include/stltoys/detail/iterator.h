@@ -107,4 +107,45 @@ namespace ccat::detail {
 
 	template<bool Mutable, typename T>
 	using random_access_iterator = generic_random_access_iterator<Mutable, T, std::random_access_iterator_tag>;
+
+	template<typename T>
+	class repeat_iterator { // yields the same value over and over, counting its position
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using pointer = const value_type*;
+		using reference = const value_type&;
+		using difference_type = std::ptrdiff_t;
+	public:
+		CONSTEXPR repeat_iterator() noexcept = default;
+
+		CONSTEXPR explicit repeat_iterator(const value_type& value, difference_type pos = 0) noexcept : ptr_(std::addressof(value)), pos_(pos) {}
+
+		CONSTEXPR auto operator++ () noexcept -> repeat_iterator& {
+			++pos_;
+			return *this;
+		}
+
+		CONSTEXPR auto operator++ (int) noexcept -> repeat_iterator {
+			auto tmp = *this;
+			++pos_;
+			return tmp;
+		}
+
+		NODISCARD CONSTEXPR auto operator* () const noexcept -> reference {
+			return *ptr_;
+		}
+
+		CONSTEXPR auto operator-> () const noexcept -> pointer {
+			return ptr_;
+		}
+
+		friend CONSTEXPR auto operator== (const repeat_iterator& lhs, const repeat_iterator& rhs) noexcept -> bool {
+			return lhs.pos_ == rhs.pos_;
+		}
+
+	private:
+		pointer ptr_ = nullptr;
+		difference_type pos_ = 0;
+	};
 }
\ No newline at end of file
@@ -0,0 +1,398 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include "config.h"
+#include "../char_traits.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace ccat::detail {
+	// Substring search behind `basic_string_view_like::find` and `rfind`. Both return the index of the match in `txt`
+	// or `string_search_npos`. At compile time, and for user-supplied traits whose `eq` may not be plain equality,
+	// they compare character by character. Otherwise the needle length picks the tier: a single character goes to
+	// `memchr`, a short needle to a SIMD filter on its first and last characters, and a long one to Boyer-Moore-Horspool.
+	// The `find_*_of` family goes through `find_of`, which builds a membership bitmap of the set once per call, and
+	// `operator==` goes through `equal`, which only needs to know whether some block differs, not where.
+	// The SIMD paths are chosen at compile time from `__SSE2__`, `__SSSE3__` and `__AVX2__`; there is no runtime
+	// dispatch, so a default x86-64 build (SSE2 only) scans byte sets through the bitmap rather than `pshufb`.
+	inline constexpr std::size_t string_search_npos = static_cast<std::size_t>(-1);
+
+	inline constexpr std::size_t string_search_long_needle = 32; // from here on the skip table pays for itself
+
+	template<typename Traits>
+	concept bitwise_char_traits = std::same_as<Traits, char_traits<typename Traits::char_type>>;
+
+	template<typename CharT>
+	concept byte_char = sizeof(CharT) == 1;
+
+	template<bool FromLeftToRight, typename Traits>
+	CONSTEXPR auto naive_search(const typename Traits::char_type* txt, std::size_t n, const typename Traits::char_type* pat, std::size_t m) noexcept ->std::size_t {
+		if (n < m) return string_search_npos;
+		std::size_t last = n - m;
+		for (std::size_t i = 0; i <= last; ++i) {
+			std::size_t idx = FromLeftToRight ? i : last - i;
+			std::size_t j = 0;
+			while (j < m && Traits::eq(txt[idx + j], pat[j])) ++j;
+			if (j == m) return idx;
+		}
+		return string_search_npos;
+	}
+
+	template<typename CharT>
+	auto char_key(CharT ch) noexcept ->unsigned char { // wider characters share buckets by their low byte
+		return static_cast<unsigned char>(static_cast<std::make_unsigned_t<CharT>>(ch));
+	}
+
+	template<typename CharT>
+	auto equal_chars(const CharT* s1, const CharT* s2, std::size_t count) noexcept ->bool {
+		return std::memcmp(s1, s2, count * sizeof(CharT)) == 0;
+	}
+
+	template<typename CharT>
+	auto find_char(const CharT* txt, std::size_t n, CharT ch) noexcept ->std::size_t {
+		if constexpr (byte_char<CharT>) {
+			auto p = static_cast<const CharT*>(std::memchr(txt, static_cast<unsigned char>(ch), n));
+			return p ? static_cast<std::size_t>(p - txt) : string_search_npos;
+		}
+		else {
+			auto p = char_traits<CharT>::find(txt, n, ch);
+			return p ? static_cast<std::size_t>(p - txt) : string_search_npos;
+		}
+	}
+
+	template<typename CharT>
+	auto rfind_char(const CharT* txt, std::size_t n, CharT ch) noexcept ->std::size_t {
+#if defined(__GLIBC__)
+		if constexpr (byte_char<CharT>) {
+			auto p = static_cast<const CharT*>(::memrchr(txt, static_cast<unsigned char>(ch), n));
+			return p ? static_cast<std::size_t>(p - txt) : string_search_npos;
+		}
+#endif
+		while (n > 0) {
+			if (txt[--n] == ch) return n;
+		}
+		return string_search_npos;
+	}
+
+	template<typename CharT>
+	auto first_last_search(const CharT* txt, std::size_t n, const CharT* pat, std::size_t m) noexcept ->std::size_t { // 2 <= m <= n
+		std::size_t i = 0;
+		if constexpr (byte_char<CharT>) {
+			auto bytes = reinterpret_cast<const char*>(txt);
+			auto check = [&](std::size_t pos, std::uint32_t mask) ->std::size_t { // `mask` marks the positions whose first and last characters match
+				for (; mask != 0; mask &= mask - 1) {
+					auto candidate = pos + static_cast<std::size_t>(std::countr_zero(mask));
+					if (equal_chars(txt + candidate + 1, pat + 1, m - 2)) return candidate;
+				}
+				return string_search_npos;
+			};
+#if defined(__AVX2__)
+			const __m256i first32 = _mm256_set1_epi8(static_cast<char>(pat[0]));
+			const __m256i last32 = _mm256_set1_epi8(static_cast<char>(pat[m - 1]));
+			for (; i + m - 1 + 32 <= n; i += 32) {
+				auto eq_first = _mm256_cmpeq_epi8(first32, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i)));
+				auto eq_last = _mm256_cmpeq_epi8(last32, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i + m - 1)));
+				auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last)));
+				if (auto res = check(i, mask); res != string_search_npos) return res;
+			}
+#endif
+#if defined(__SSE2__)
+			const __m128i first16 = _mm_set1_epi8(static_cast<char>(pat[0]));
+			const __m128i last16 = _mm_set1_epi8(static_cast<char>(pat[m - 1]));
+			for (; i + m - 1 + 16 <= n; i += 16) {
+				auto eq_first = _mm_cmpeq_epi8(first16, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)));
+				auto eq_last = _mm_cmpeq_epi8(last16, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i + m - 1)));
+				auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)));
+				if (auto res = check(i, mask); res != string_search_npos) return res;
+			}
+#endif
+			(void) bytes;
+			(void) check;
+		}
+		while (i + m <= n) { // the tail, or everything without SIMD: jump from one occurrence of the first character to the next
+			auto hit = find_char(txt + i, n - m + 1 - i, pat[0]);
+			if (hit == string_search_npos) break;
+			i += hit;
+			if (txt[i + m - 1] == pat[m - 1] && equal_chars(txt + i + 1, pat + 1, m - 2)) return i;
+			++i;
+		}
+		return string_search_npos;
+	}
+
+	template<typename CharT>
+	auto horspool_search(const CharT* txt, std::size_t n, const CharT* pat, std::size_t m) noexcept ->std::size_t { // 2 <= m <= n
+		std::size_t shift[256];
+		std::fill(std::begin(shift), std::end(shift), m);
+		for (std::size_t j = 0; j + 1 < m; ++j) shift[char_key(pat[j])] = m - 1 - j;
+		auto last = pat[m - 1];
+		for (std::size_t i = 0; i + m <= n; i += shift[char_key(txt[i + m - 1])]) {
+			if (txt[i + m - 1] == last && equal_chars(txt + i, pat, m - 1)) return i;
+		}
+		return string_search_npos;
+	}
+
+	template<typename CharT>
+	auto reverse_horspool_search(const CharT* txt, std::size_t n, const CharT* pat, std::size_t m) noexcept ->std::size_t { // 2 <= m <= n
+		std::size_t shift[256];
+		std::fill(std::begin(shift), std::end(shift), m);
+		for (std::size_t j = m - 1; j > 0; --j) shift[char_key(pat[j])] = j;
+		auto first = pat[0];
+		for (std::size_t i = n - m;; i -= shift[char_key(txt[i])]) {
+			if (txt[i] == first && equal_chars(txt + i + 1, pat + 1, m - 1)) return i;
+			if (i < shift[char_key(txt[i])]) break;
+		}
+		return string_search_npos;
+	}
+
+	template<typename Traits>
+	CONSTEXPR auto search(const typename Traits::char_type* txt, std::size_t n, const typename Traits::char_type* pat, std::size_t m) noexcept ->std::size_t {
+		if (m == 0) return 0;
+		if (n < m) return string_search_npos;
+		if constexpr (bitwise_char_traits<Traits>) {
+			if (!std::is_constant_evaluated()) {
+				if (m == 1) return find_char(txt, n, pat[0]);
+				if (m < string_search_long_needle) return first_last_search(txt, n, pat, m);
+				return horspool_search(txt, n, pat, m);
+			}
+		}
+		return naive_search<true, Traits>(txt, n, pat, m);
+	}
+
+	template<typename Traits>
+	CONSTEXPR auto rsearch(const typename Traits::char_type* txt, std::size_t n, const typename Traits::char_type* pat, std::size_t m) noexcept ->std::size_t {
+		if (n < m) return string_search_npos;
+		if (m == 0) return n;
+		if constexpr (bitwise_char_traits<Traits>) {
+			if (!std::is_constant_evaluated()) {
+				if (m == 1) return rfind_char(txt, n, pat[0]);
+				return reverse_horspool_search(txt, n, pat, m);
+			}
+		}
+		return naive_search<false, Traits>(txt, n, pat, m);
+	}
+
+	template<typename CharT>
+	class char_set { // a 256-bit membership bitmap; exact for byte characters, in front of a hash table for wider ones
+	public:
+		char_set(const CharT* chars, std::size_t count) noexcept : chars_(chars), count_(count) {
+			for (std::size_t i = 0; i < count; ++i) {
+				auto key = char_key(chars[i]);
+				bits_[key >> 6] |= std::uint64_t{1} << (key & 63);
+			}
+			if constexpr (!byte_char<CharT>) {
+				if (count != 0) build_table_();
+			}
+		}
+
+		char_set(const char_set&) = delete;
+
+		~char_set() {
+			if (table_ != inline_table_) delete[] table_;
+		}
+
+		auto operator= (const char_set&) ->char_set& = delete;
+
+		auto contains(CharT ch) const noexcept ->bool {
+			auto key = char_key(ch);
+			if ((bits_[key >> 6] >> (key & 63) & 1) == 0) return false;
+			if constexpr (byte_char<CharT>) return true;
+			else {
+				if (table_ == nullptr) [[unlikely]] return find_char(chars_, count_, ch) != string_search_npos; // no memory for the table
+				auto empty = chars_[0];
+				if (ch == empty) return true;
+				for (auto i = slot_(ch);; i = (i + 1) & mask_) {
+					if (table_[i] == ch) return true;
+					if (table_[i] == empty) return false;
+				}
+			}
+		}
+	private:
+		static constexpr std::size_t inline_slots = byte_char<CharT> ? 1 : 128;
+
+		// open addressing with linear probing; a free slot holds `chars_[0]`, which is answered before probing
+		auto build_table_() noexcept ->void {
+			std::size_t slots = std::bit_ceil(std::max<std::size_t>(count_ * 2, 2));
+			table_ = slots <= inline_slots ? inline_table_ : new (std::nothrow) CharT[slots];
+			if (table_ == nullptr) return;
+			mask_ = slots - 1;
+			shift_ = 64 - std::countr_zero(slots);
+			auto empty = chars_[0];
+			std::fill_n(table_, slots, empty);
+			for (std::size_t j = 1; j < count_; ++j) {
+				auto ch = chars_[j];
+				if (ch == empty) continue;
+				auto i = slot_(ch);
+				while (table_[i] != empty && table_[i] != ch) i = (i + 1) & mask_;
+				table_[i] = ch;
+			}
+		}
+
+		auto slot_(CharT ch) const noexcept ->std::size_t { // Fibonacci hashing keeps neighbouring code points apart
+			auto key = static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<CharT>>(ch));
+			return static_cast<std::size_t>(key * 0x9e3779b97f4a7c15ull >> shift_);
+		}
+	private:
+		std::uint64_t bits_[4]{};
+		const CharT* chars_;
+		std::size_t count_;
+		CharT* table_ = nullptr;
+		std::size_t mask_ = 0;
+		int shift_ = 63;
+		CharT inline_table_[inline_slots];
+	};
+
+#if defined(__SSSE3__)
+	class nibble_classifier { // tests 16 or 32 bytes at once against a byte set with `pshufb` lookups on both nibbles
+	public:
+		template<typename CharT>
+		nibble_classifier(const CharT* chars, std::size_t count) noexcept {
+			alignas(16) unsigned char low[16]{}, high[16]{}; // row `l` holds bit `h & 7` for every member `h << 4 | l`, split by the top bit
+			for (std::size_t i = 0; i < count; ++i) {
+				auto byte = static_cast<unsigned char>(chars[i]);
+				(byte < 0x80 ? low : high)[byte & 15] |= static_cast<unsigned char>(1u << (byte >> 4 & 7));
+			}
+			low_ = _mm_load_si128(reinterpret_cast<const __m128i*>(low));
+			high_ = _mm_load_si128(reinterpret_cast<const __m128i*>(high));
+		}
+
+		auto match(const void* p) const noexcept ->std::uint32_t { // bit `i` is set when byte `i` is in the set
+			const __m128i nibble = _mm_set1_epi8(0x0f);
+			const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+			auto block = _mm_loadu_si128(static_cast<const __m128i*>(p));
+			auto lo = _mm_and_si128(block, nibble);
+			auto hi = _mm_and_si128(_mm_srli_epi16(block, 4), nibble);
+			auto top = _mm_cmplt_epi8(block, _mm_setzero_si128());
+			auto rows = _mm_or_si128(_mm_and_si128(top, _mm_shuffle_epi8(high_, lo)), _mm_andnot_si128(top, _mm_shuffle_epi8(low_, lo)));
+			auto miss = _mm_cmpeq_epi8(_mm_and_si128(rows, _mm_shuffle_epi8(bits, hi)), _mm_setzero_si128());
+			return ~static_cast<std::uint32_t>(_mm_movemask_epi8(miss)) & 0xffff;
+		}
+
+#if defined(__AVX2__)
+		auto match_wide(const void* p) const noexcept ->std::uint32_t { // the same on 32 bytes
+			const __m256i nibble = _mm256_set1_epi8(0x0f);
+			const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+			auto low = _mm256_broadcastsi128_si256(low_);
+			auto high = _mm256_broadcastsi128_si256(high_);
+			auto block = _mm256_loadu_si256(static_cast<const __m256i*>(p));
+			auto lo = _mm256_and_si256(block, nibble);
+			auto hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble);
+			auto top = _mm256_cmpgt_epi8(_mm256_setzero_si256(), block);
+			auto rows = _mm256_or_si256(_mm256_and_si256(top, _mm256_shuffle_epi8(high, lo)), _mm256_andnot_si256(top, _mm256_shuffle_epi8(low, lo)));
+			auto miss = _mm256_cmpeq_epi8(_mm256_and_si256(rows, _mm256_shuffle_epi8(bits, hi)), _mm256_setzero_si256());
+			return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(miss));
+		}
+#endif
+	private:
+		__m128i low_;
+		__m128i high_;
+	};
+#endif
+
+	template<bool FromLeftToRight, bool Member, typename CharT>
+	auto set_scan(const CharT* txt, std::size_t n, const CharT* chars, std::size_t count) noexcept ->std::size_t {
+		if constexpr (Member) {
+			if (count == 1) return FromLeftToRight ? find_char(txt, n, chars[0]) : rfind_char(txt, n, chars[0]);
+		}
+		std::size_t lo = 0, hi = n; // what is still to be scanned
+#if defined(__SSSE3__)
+		if constexpr (byte_char<CharT>) {
+			if (n >= 16) {
+				nibble_classifier classifier{chars, count};
+				auto hit = [](std::uint32_t mask, std::uint32_t full) ->std::uint32_t {
+					return Member ? mask : ~mask & full;
+				};
+				if constexpr (FromLeftToRight) {
+#if defined(__AVX2__)
+					for (; lo + 32 <= hi; lo += 32) {
+						if (auto mask = hit(classifier.match_wide(txt + lo), 0xffffffff)) return lo + std::countr_zero(mask);
+					}
+#endif
+					for (; lo + 16 <= hi; lo += 16) {
+						if (auto mask = hit(classifier.match(txt + lo), 0xffff)) return lo + std::countr_zero(mask);
+					}
+				}
+				else {
+#if defined(__AVX2__)
+					for (; hi - lo >= 32; hi -= 32) {
+						if (auto mask = hit(classifier.match_wide(txt + hi - 32), 0xffffffff)) return hi - 32 + std::bit_width(mask) - 1;
+					}
+#endif
+					for (; hi - lo >= 16; hi -= 16) {
+						if (auto mask = hit(classifier.match(txt + hi - 16), 0xffff)) return hi - 16 + std::bit_width(mask) - 1;
+					}
+				}
+			}
+		}
+#endif
+		char_set<CharT> set{chars, count};
+		if constexpr (FromLeftToRight) {
+			for (; lo < hi; ++lo) {
+				if (set.contains(txt[lo]) == Member) return lo;
+			}
+		}
+		else {
+			while (hi > lo) {
+				if (set.contains(txt[--hi]) == Member) return hi;
+			}
+		}
+		return string_search_npos;
+	}
+
+	template<bool FromLeftToRight, bool Member, typename Traits>
+	CONSTEXPR auto find_of(const typename Traits::char_type* txt, std::size_t n, const typename Traits::char_type* chars, std::size_t count) noexcept ->std::size_t {
+		if constexpr (bitwise_char_traits<Traits>) {
+			if (!std::is_constant_evaluated()) return set_scan<FromLeftToRight, Member>(txt, n, chars, count);
+		}
+		auto in_set = [&](typename Traits::char_type ch) {
+			for (std::size_t j = 0; j < count; ++j) {
+				if (Traits::eq(ch, chars[j])) return true;
+			}
+			return false;
+		};
+		for (std::size_t i = 0; i < n; ++i) {
+			std::size_t idx = FromLeftToRight ? i : n - 1 - i;
+			if (in_set(txt[idx]) == Member) return idx;
+		}
+		return string_search_npos;
+	}
+
+	inline auto equal_bytes(const unsigned char* s1, const unsigned char* s2, std::size_t n) noexcept ->bool {
+		std::size_t i = 0;
+#if defined(__AVX2__)
+		for (; i + 32 <= n; i += 32) {
+			auto eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s1 + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s2 + i)));
+			if (_mm256_movemask_epi8(eq) != -1) return false;
+		}
+#endif
+#if defined(__SSE2__)
+		for (; i + 16 <= n; i += 16) {
+			auto eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s2 + i)));
+			if (_mm_movemask_epi8(eq) != 0xffff) return false;
+		}
+#endif
+		return std::memcmp(s1 + i, s2 + i, n - i) == 0;
+	}
+
+	template<typename Traits>
+	CONSTEXPR auto equal(const typename Traits::char_type* s1, const typename Traits::char_type* s2, std::size_t n) noexcept ->bool {
+		if constexpr (bitwise_char_traits<Traits>) {
+			if (!std::is_constant_evaluated()) {
+				if (s1 == s2 || n == 0) return true;
+				return equal_bytes(reinterpret_cast<const unsigned char*>(s1), reinterpret_cast<const unsigned char*>(s2), n * sizeof(*s1));
+			}
+		}
+		return Traits::compare(s1, s2, n) == 0;
+	}
+}
\ No newline at end of file
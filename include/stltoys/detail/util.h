@@ -5,6 +5,8 @@
 #include <stdexcept>
 #include <utility>
 #include <memory>
+#include <type_traits>
+#include "config.h"
 
 namespace ccat {
 
@@ -39,9 +41,34 @@ namespace ccat {
 	};
 
 	inline constexpr from_range_t from_range{};
+
+	template<typename T> // specialize it as `std::true_type` to opt a type in
+	struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+	template<typename T>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	template<typename Pointer, typename SizeType = std::size_t>
+	struct allocation_result { // the storage `allocate_at_least` and `reallocate` hand back: `ptr` holds `count` elements
+		Pointer ptr;
+		SizeType count;
+	};
 }
 
 namespace ccat::detail {
+	inline constexpr std::size_t cache_line_size = 64;
+
+	template<typename Alloc>
+	NODISCARD CONSTEXPR auto alloc_allocate_at_least(Alloc& alloc, typename std::allocator_traits<Alloc>::size_type n) ->allocation_result<typename std::allocator_traits<Alloc>::pointer, typename std::allocator_traits<Alloc>::size_type> {
+		if constexpr (requires { alloc.allocate_at_least(n); }) { // may return more than `n`, which must be passed back to `deallocate`
+			auto [ptr, count] = alloc.allocate_at_least(n);
+			return {ptr, static_cast<typename std::allocator_traits<Alloc>::size_type>(count)};
+		}
+		else {
+			return {std::allocator_traits<Alloc>::allocate(alloc, n), n};
+		}
+	}
+
 	template<std::input_iterator InputIt, std::forward_iterator ForwardIt, typename Alloc>
 	CONSTEXPR auto alloc_uninitialized_copy(InputIt first, InputIt last, ForwardIt d_first, Alloc& alloc) ->ForwardIt {
 		ForwardIt current = d_first;
@@ -59,6 +86,23 @@ namespace ccat::detail {
 		}
 	}
 
+	template<std::input_iterator InputIt, std::forward_iterator ForwardIt, typename Alloc>
+	CONSTEXPR auto alloc_uninitialized_copy_n(InputIt first, std::size_t count, ForwardIt d_first, Alloc& alloc) ->ForwardIt {
+		ForwardIt current = d_first;
+		try {
+			for (; count > 0; ++first, ++current, --count) {
+				std::allocator_traits<Alloc>::construct(alloc, std::to_address(current), *first);
+			}
+			return current;
+		}
+		catch (...) {
+			for (; d_first != current; ++d_first) {
+				std::allocator_traits<Alloc>::destroy(alloc, std::to_address(d_first));
+			}
+			throw;
+		}
+	}
+
 	template<std::input_iterator InputIt, std::forward_iterator ForwardIt, typename Alloc>
 	CONSTEXPR auto alloc_uninitialized_move(InputIt first, InputIt last, ForwardIt d_first, Alloc& alloc) ->ForwardIt {
 		ForwardIt current = d_first;
@@ -92,6 +136,15 @@ namespace ccat::detail {
 		}
 	}
 
+	template<std::forward_iterator ForwardIt, typename Alloc>
+	CONSTEXPR auto alloc_uninitialized_default_init(ForwardIt first, ForwardIt last, Alloc& alloc) ->void { // leaves trivial objects uninitialized
+		using value_type = std::iter_value_t<ForwardIt>;
+		if constexpr (std::is_trivially_default_constructible_v<value_type> && !requires (Alloc& a, value_type* p) { a.construct(p); }) {
+			if (!std::is_constant_evaluated()) return;
+		}
+		alloc_uninitialized_default_construct(first, last, alloc);
+	}
+
 	template<std::forward_iterator ForwardIt, typename T, typename Alloc>
 	CONSTEXPR auto alloc_uninitialized_fill(ForwardIt first, ForwardIt last, const T& v, Alloc& alloc) ->void {
 		ForwardIt current = first;
@@ -114,4 +167,11 @@ namespace ccat::detail {
 			std::allocator_traits<Alloc>::destroy(alloc, std::to_address(first));
 		}
 	}
+
+	template<typename T> requires is_trivially_relocatable_v<T>
+	auto trivially_relocate(T* first, T* last, T* d_first) noexcept ->T* { // the ranges may overlap
+		auto count = last - first;
+		if (count > 0) std::memmove(static_cast<void*>(d_first), static_cast<const void*>(first), count * sizeof(T));
+		return d_first + count;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,592 @@
+#pragma once
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include "config.h"
+#include "iterator.h"
+#include "concepts.h"
+#include "util.h"
+#include "../growth_policy.h"
+
+namespace ccat::detail {
+	// the storage and element machinery shared by vector (`N == 0`) and small_vector (`N` elements inline);
+	// a capacity up to `N` means the inline buffer, which is only ever the target when the elements live on the heap
+	template<typename T, typename Alloc, typename GrowthPolicy, std::size_t N>
+	class vector_base {
+	public:
+		using value_type = T;
+		using allocator_type = Alloc;
+		using growth_policy_type = GrowthPolicy;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = typename std::allocator_traits<allocator_type>::pointer;
+		using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using iterator = detail::contiguous_iterator<true, value_type>;
+		using const_iterator = detail::contiguous_iterator<false, value_type>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	protected:
+		CONSTEXPR vector_base() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) {}
+
+		CONSTEXPR explicit vector_base(const allocator_type& alloc) noexcept : alloc_(alloc) {}
+
+		CONSTEXPR explicit vector_base(allocator_type&& alloc) noexcept : alloc_(std::move(alloc)) {}
+
+		vector_base(const vector_base&) = delete;
+
+		CONSTEXPR ~vector_base() {
+			die_();
+		}
+
+		auto operator= (const vector_base&) ->vector_base& = delete;
+	public:
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR auto assign_range(Range&& rng) ->void requires
+			std::assignable_from<T&, std::ranges::range_reference_t<Range>> &&
+			concepts::emplace_constructible_from<value_type, vector_base, std::ranges::range_reference_t<Range>> &&
+			(std::ranges::sized_range<Range> || std::ranges::forward_range<Range> ? true : concepts::move_insertable_into<value_type, vector_base>)
+		{
+			auto ptr = beg_;
+			auto rng_it = std::ranges::begin(rng);
+			auto rng_end = std::ranges::end(rng);
+			while (ptr != end_ && rng_it != rng_end) {
+				*ptr = *rng_it;
+				++ptr;
+				++rng_it;
+			}
+			detail::alloc_destroy(ptr, end_, alloc_);
+			end_ = ptr;
+			(void) this->append_range_impl_(std::move(rng_it), std::move(rng_end));
+		}
+
+		NODISCARD CONSTEXPR auto begin() noexcept ->iterator {
+			return {beg_};
+		}
+
+		NODISCARD CONSTEXPR auto begin() const noexcept ->const_iterator {
+			return {beg_};
+		}
+
+		NODISCARD CONSTEXPR auto cbegin() const noexcept ->const_iterator {
+			return begin();
+		}
+
+		NODISCARD CONSTEXPR auto rbegin() noexcept ->reverse_iterator {
+			return std::make_reverse_iterator(end());
+		}
+
+		NODISCARD CONSTEXPR auto rbegin() const noexcept ->const_reverse_iterator {
+			return std::make_reverse_iterator(end());
+		}
+
+		NODISCARD CONSTEXPR auto crbegin() const noexcept ->const_reverse_iterator {
+			return rbegin();
+		}
+
+		NODISCARD CONSTEXPR auto end() noexcept ->iterator {
+			return {end_};
+		}
+
+		NODISCARD CONSTEXPR auto end() const noexcept ->const_iterator {
+			return {end_};
+		}
+
+		NODISCARD CONSTEXPR auto cend() const noexcept ->const_iterator {
+			return end();
+		}
+
+		NODISCARD CONSTEXPR auto rend() noexcept ->reverse_iterator {
+			return std::make_reverse_iterator(begin());
+		}
+
+		NODISCARD CONSTEXPR auto rend() const noexcept ->const_reverse_iterator {
+			return std::make_reverse_iterator(begin());
+		}
+
+		NODISCARD CONSTEXPR auto crend() const noexcept ->const_reverse_iterator {
+			return rend();
+		}
+
+		NODISCARD CONSTEXPR auto size() const noexcept ->size_type {
+			return end_ - beg_;
+		}
+
+		NODISCARD CONSTEXPR auto max_size() const noexcept ->size_type {
+			return std::numeric_limits<difference_type>::max();
+		}
+
+		NODISCARD CONSTEXPR auto empty() const noexcept ->bool {
+			return beg_ == end_;
+		}
+
+		NODISCARD CONSTEXPR auto capacity() const noexcept ->size_type {
+			return cap_ - beg_;
+		}
+
+		NODISCARD CONSTEXPR auto operator[] (size_type index) noexcept ->reference {
+			return beg_[index];
+		}
+
+		NODISCARD CONSTEXPR auto operator[] (size_type index) const noexcept ->const_reference {
+			return beg_[index];
+		}
+
+		NODISCARD CONSTEXPR auto front() noexcept ->reference {
+			return *beg_;
+		}
+
+		NODISCARD CONSTEXPR auto front() const noexcept ->const_reference {
+			return *beg_;
+		}
+
+		NODISCARD CONSTEXPR auto back() noexcept ->reference {
+			return *(end_ - 1);
+		}
+
+		NODISCARD CONSTEXPR auto back() const noexcept ->const_reference {
+			return *(end_ - 1);
+		}
+
+		NODISCARD CONSTEXPR auto get_allocator() const noexcept ->allocator_type {
+			return alloc_;
+		}
+
+		NODISCARD CONSTEXPR auto data() noexcept ->pointer {
+			return beg_;
+		}
+
+		NODISCARD CONSTEXPR auto data() const noexcept ->const_pointer {
+			return beg_;
+		}
+
+		CONSTEXPR auto resize(size_type new_size) ->void requires concepts::move_insertable_into<value_type, vector_base> && concepts::default_insertable_into<value_type, vector_base> {
+			this->resize_impl_(new_size, [this](pointer first, pointer last) {
+				detail::alloc_uninitialized_default_construct(first, last, alloc_);
+			});
+		}
+
+		CONSTEXPR auto resize(size_type new_size, const_reference value) ->void requires concepts::copy_insertable_into<value_type, vector_base> {
+			this->resize_impl_(new_size, [this, &value](pointer first, pointer last) {
+				detail::alloc_uninitialized_fill(first, last, value, alloc_);
+			});
+		}
+
+		CONSTEXPR auto resize_for_overwrite(size_type new_size) ->void requires concepts::move_insertable_into<value_type, vector_base> && concepts::default_insertable_into<value_type, vector_base> { // new elements are default-initialized
+			this->resize_impl_(new_size, [this](pointer first, pointer last) {
+				detail::alloc_uninitialized_default_init(first, last, alloc_);
+			});
+		}
+
+		CONSTEXPR auto reserve(size_type new_capacity) ->void requires concepts::move_insertable_into<value_type, vector_base> {
+			if (new_capacity <= capacity()) return;
+			realloc_(this->grow_(new_capacity));
+		}
+
+		CONSTEXPR auto clear() noexcept ->void {
+			detail::alloc_destroy(beg_, end_, alloc_);
+			end_ = beg_;
+		}
+
+		CONSTEXPR auto erase(const_iterator pos) ->iterator requires concepts::move_assignable<value_type> {
+			return this->erase(pos, pos + 1);
+		}
+
+		CONSTEXPR auto erase(const_iterator first, const_iterator last) ->iterator requires concepts::move_assignable<value_type> {
+			auto idx = first - cbegin();
+			if (first == last) return begin() + idx;
+			auto distance_ = last - first;
+			auto first_ = beg_ + idx;
+			auto last_ = beg_ + (last - cbegin());
+			if constexpr (relocatable_) {
+				if (!std::is_constant_evaluated()) {
+					detail::alloc_destroy(first_, last_, alloc_);
+					detail::trivially_relocate(std::to_address(last_), std::to_address(end_), std::to_address(first_));
+					end_ -= distance_;
+					return begin() + idx;
+				}
+			}
+			std::move(last_, end_, first_);
+			detail::alloc_destroy(end_ - distance_, end_, alloc_);
+			end_ -= distance_;
+			return begin() + idx;
+		}
+
+		CONSTEXPR auto pop_back() ->void {
+			(void) this->erase(end_ - 1);
+		}
+
+		template<typename... Args> requires concepts::move_assignable<value_type> && concepts::move_insertable_into<value_type, vector_base> && concepts::emplace_constructible_from<value_type, vector_base, Args...>
+		CONSTEXPR auto emplace(const_iterator pos, Args&&... args) ->iterator {
+			if (pos == cend()) {
+				this->emplace_back(std::forward<Args>(args)...);
+				return end_ - 1;
+			}
+			auto idx = (pos - cbegin());
+			if (size() == capacity()) {
+				return this->realloc_insert_(this->grow_(size() + 1), idx, 1, [&](pointer gap) {
+					std::allocator_traits<allocator_type>::construct(alloc_, std::to_address(gap), std::forward<Args>(args)...);
+				});
+			}
+			auto where_ = beg_ + idx;
+			value_type tmp(std::forward<Args>(args)...);
+			if constexpr (relocatable_) {
+				if (!std::is_constant_evaluated()) {
+					detail::trivially_relocate(std::to_address(where_), std::to_address(end_), std::to_address(where_ + 1));
+					try {
+						std::allocator_traits<allocator_type>::construct(alloc_, std::to_address(where_), std::move(tmp));
+					}
+					catch (...) {
+						detail::trivially_relocate(std::to_address(where_ + 1), std::to_address(end_ + 1), std::to_address(where_));
+						throw;
+					}
+					++end_;
+					return where_;
+				}
+			}
+			std::allocator_traits<allocator_type>::construct(alloc_, end_, std::move(back()));
+			std::move_backward(where_, end_ - 1, end_);
+			*where_ = std::move(tmp);
+			++end_;
+			return where_;
+		}
+
+		template<typename... Args> requires concepts::move_insertable_into<value_type, vector_base> && concepts::emplace_constructible_from<value_type, vector_base, Args...>
+		CONSTEXPR auto emplace_back(Args&&... args) ->reference {
+			if (size() == capacity()) {
+				if constexpr (reallocatable_) {
+					if (!std::is_constant_evaluated() && this->on_heap_()) { // `args` may refer to an element, so take a copy before the buffer moves
+						value_type tmp(std::forward<Args>(args)...);
+						this->realloc_(this->grow_(size() + 1));
+						std::allocator_traits<allocator_type>::construct(alloc_, std::to_address(end_), std::move(tmp));
+						++end_;
+						return back();
+					}
+				}
+				this->realloc_insert_(this->grow_(size() + 1), size(), 1, [&](pointer gap) {
+					std::allocator_traits<allocator_type>::construct(alloc_, std::to_address(gap), std::forward<Args>(args)...);
+				});
+			}
+			else {
+				std::allocator_traits<allocator_type>::construct(alloc_, end_, std::forward<Args>(args)...);
+				++end_;
+			}
+			return back();
+		}
+
+		CONSTEXPR auto push_back(const value_type& value) ->void requires concepts::copy_insertable_into<value_type, vector_base> {
+			this->emplace_back(value);
+		}
+
+		CONSTEXPR auto push_back(value_type&& value) ->void requires concepts::move_insertable_into<value_type, vector_base> {
+			this->emplace_back(std::move(value));
+		}
+
+		CONSTEXPR auto insert(const_iterator pos, const_reference value) ->iterator requires concepts::copy_assignable<value_type> && concepts::copy_insertable_into<value_type, vector_base> {
+			return this->emplace(pos, value);
+		}
+
+		CONSTEXPR auto insert(const_iterator pos, value_type&& value) ->iterator requires concepts::move_assignable<value_type> && concepts::move_insertable_into<value_type, vector_base> {
+			return this->emplace(pos, std::move(value));
+		}
+
+		CONSTEXPR auto insert(const_iterator pos, size_type count, const_reference value) ->iterator requires concepts::copy_assignable<value_type> && concepts::copy_insertable_into<value_type, vector_base> {
+			auto idx = pos - cbegin();
+			if (count == 0) return begin() + idx;
+			value_type tmp(value); // `value` may live in the range being shifted
+			return this->insert_n_(idx, count, detail::repeat_iterator<value_type>{tmp});
+		}
+
+		template<std::input_iterator InputIt> requires concepts::emplace_constructible_from<value_type, vector_base, std::iter_value_t<InputIt>> && std::movable<value_type> && concepts::move_insertable_into<value_type, vector_base>
+		CONSTEXPR auto insert(const_iterator pos, InputIt first, InputIt last) ->iterator {
+			return this->insert_range_impl_(pos - cbegin(), std::move(first), std::move(last));
+		}
+
+		CONSTEXPR auto insert(const_iterator pos, std::initializer_list<value_type> ilist) ->iterator requires std::movable<value_type> && concepts::move_insertable_into<value_type, vector_base> {
+			return this->insert_n_(pos - cbegin(), ilist.size(), ilist.begin());
+		}
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR auto insert_range(const_iterator pos, Range&& rng) ->iterator requires concepts::emplace_constructible_from<value_type, vector_base, std::ranges::range_reference_t<Range>> && std::movable<value_type> && concepts::move_insertable_into<value_type, vector_base> {
+			if constexpr (std::ranges::forward_range<Range> && std::ranges::sized_range<Range>) {
+				return this->insert_n_(pos - cbegin(), std::ranges::size(rng), std::ranges::begin(rng));
+			}
+			else {
+				return this->insert_range_impl_(pos - cbegin(), std::ranges::begin(rng), std::ranges::end(rng));
+			}
+		}
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR auto append_range(Range&& rng) ->void requires concepts::emplace_constructible_from<value_type, vector_base, std::ranges::range_reference_t<Range>> && concepts::move_insertable_into<value_type, vector_base> {
+			if constexpr (std::ranges::sized_range<Range>) {
+				(void) this->append_n_(std::ranges::begin(rng), std::ranges::size(rng));
+			}
+			else {
+				(void) this->append_range_impl_(std::ranges::begin(rng), std::ranges::end(rng));
+			}
+		}
+
+		CONSTEXPR friend auto operator== (const vector_base& lhs, const vector_base& rhs) noexcept ->bool {
+			if (lhs.size() != rhs.size()) return false;
+			for (size_type i = 0; i < lhs.size(); ++i) {
+				if (lhs[i] != rhs[i]) return false;
+			}
+			return true;
+		}
+
+		CONSTEXPR friend auto operator<=> (const vector_base& lhs, const vector_base& rhs) noexcept {
+			return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+	protected:
+
+		NODISCARD CONSTEXPR auto on_heap_() const noexcept ->bool {
+			if constexpr (N > 0) return beg_ != inline_.elems_;
+			else return beg_ != nullptr;
+		}
+
+		CONSTEXPR auto inline_data_() noexcept ->pointer { // null without an inline buffer
+			if constexpr (N > 0) return inline_.elems_;
+			else return nullptr;
+		}
+
+		CONSTEXPR auto die_() noexcept ->void { // leaves *this empty, back on its inline buffer if it has one
+			clear();
+			this->deallocate_(beg_, capacity());
+			beg_ = inline_data_();
+			end_ = beg_;
+			cap_ = beg_ + N;
+		}
+
+		CONSTEXPR auto steal_(vector_base& other) ->void { // assume: *this is empty and owns no heap storage; leaves `other` empty
+			if constexpr (N > 0) {
+				if (!other.on_heap_()) {
+					end_ = this->transfer_(other.beg_, other.end_, beg_);
+					other.clear();
+					return;
+				}
+			}
+			beg_ = std::exchange(other.beg_, other.inline_data_());
+			end_ = std::exchange(other.end_, other.beg_);
+			cap_ = std::exchange(other.cap_, other.beg_ + N);
+		}
+
+		CONSTEXPR auto allocate_(size_type new_capacity) ->allocation_result<pointer, size_type> { // the inline buffer when it suffices
+			if constexpr (N > 0) {
+				if (new_capacity <= N) return {inline_data_(), N};
+			}
+			return detail::alloc_allocate_at_least(alloc_, new_capacity);
+		}
+
+		CONSTEXPR auto deallocate_(pointer storage, size_type capacity_) noexcept ->void {
+			if (storage != inline_data_()) std::allocator_traits<allocator_type>::deallocate(alloc_, storage, capacity_);
+		}
+
+		template<typename InputIt, typename Sentinel>
+		CONSTEXPR auto append_range_impl_(InputIt first, Sentinel last) ->iterator {
+			if constexpr (std::forward_iterator<InputIt> || std::sized_sentinel_for<Sentinel, InputIt>) {
+				auto count = static_cast<size_type>(std::ranges::distance(first, last));
+				return this->append_n_(std::move(first), count);
+			}
+			else {
+				auto old_size_ = size();
+				for (; first != last; ++first) {
+					this->emplace_back(*first);
+				}
+				return beg_ + old_size_;
+			}
+		}
+
+		template<typename InputIt>
+		CONSTEXPR auto append_n_(InputIt first, size_type count) ->iterator { // constructs `count` elements from `first` with at most one reallocation
+			auto old_size_ = size();
+			if (count > capacity() - old_size_) this->realloc_(this->grow_(old_size_ + count));
+			if constexpr (std::contiguous_iterator<InputIt> && std::same_as<std::iter_value_t<InputIt>, value_type> && std::is_trivially_copyable_v<value_type> && relocatable_) {
+				if (!std::is_constant_evaluated()) {
+					if (count > 0) std::memcpy(static_cast<void*>(std::to_address(end_)), static_cast<const void*>(std::to_address(first)), count * sizeof(value_type));
+					end_ += count;
+					return beg_ + old_size_;
+				}
+			}
+			end_ = detail::alloc_uninitialized_copy_n(std::move(first), count, end_, alloc_);
+			return beg_ + old_size_;
+		}
+
+		template<typename InputIt, typename Sentinel>
+		CONSTEXPR auto insert_range_impl_(size_type idx, InputIt first, Sentinel last) ->iterator {
+			if (idx == size()) return this->append_range_impl_(std::move(first), std::move(last));
+			if constexpr (std::forward_iterator<InputIt>) { // insert_n_ may re-read from `first`, so only multi-pass iterators go there directly
+				auto count = static_cast<size_type>(std::ranges::distance(first, last));
+				return this->insert_n_(idx, count, std::move(first));
+			}
+			else { // single pass, sized or not: buffer first so that the tail is shifted only once
+				vector_base buffer_(alloc_);
+				(void) buffer_.append_range_impl_(std::move(first), std::move(last));
+				return this->insert_n_(idx, buffer_.size(), std::make_move_iterator(buffer_.begin()));
+			}
+		}
+
+		template<typename InputIt>
+		CONSTEXPR auto insert_n_(size_type idx, size_type count, InputIt first) ->iterator { // `first` must be readable `count` times, and may be re-read from its start
+			if (idx == size()) return this->append_n_(std::move(first), count);
+			if (count == 0) return beg_ + idx;
+			if (count > capacity() - size()) {
+				return this->realloc_insert_(this->grow_(size() + count), idx, count, [&](pointer gap) {
+					(void) detail::alloc_uninitialized_copy_n(first, count, gap, alloc_);
+				});
+			}
+			auto where_ = beg_ + idx;
+			if constexpr (relocatable_) {
+				if (!std::is_constant_evaluated()) {
+					detail::trivially_relocate(std::to_address(where_), std::to_address(end_), std::to_address(where_ + count));
+					try {
+						(void) detail::alloc_uninitialized_copy_n(first, count, where_, alloc_);
+					}
+					catch (...) {
+						detail::trivially_relocate(std::to_address(where_ + count), std::to_address(end_ + count), std::to_address(where_));
+						throw;
+					}
+					end_ += count;
+					return where_;
+				}
+			}
+			auto tail_ = static_cast<size_type>(end_ - where_);
+			if (count > tail_) { // the gap reaches past end_: the surplus elements and the shifted tail land in raw storage
+				auto new_end_ = detail::alloc_uninitialized_copy_n(std::ranges::next(first, tail_), count - tail_, end_, alloc_);
+				try {
+					new_end_ = detail::alloc_uninitialized_move(where_, end_, new_end_, alloc_);
+				}
+				catch (...) {
+					detail::alloc_destroy(end_, new_end_, alloc_);
+					throw;
+				}
+				end_ = new_end_;
+				std::copy_n(first, tail_, where_);
+			}
+			else {
+				detail::alloc_uninitialized_move(end_ - count, end_, end_, alloc_);
+				std::move_backward(where_, end_ - count, end_);
+				end_ += count;
+				std::copy_n(first, count, where_);
+			}
+			return where_;
+		}
+
+		NODISCARD CONSTEXPR auto grow_(size_type required) const noexcept ->size_type {
+			return growth_policy_type::grow(capacity(), required, alloc_);
+		}
+
+		CONSTEXPR auto transfer_(pointer first, pointer last, pointer d_first) ->pointer {
+			if constexpr (concepts::nothrow_move_insertable_into<value_type, vector_base> || !concepts::copy_insertable_into<value_type, vector_base>) {
+				return detail::alloc_uninitialized_move(first, last, d_first, alloc_);
+			}
+			else {
+				return detail::alloc_uninitialized_copy(first, last, d_first, alloc_);
+			}
+		}
+
+		// moves [beg_, end_) into `new_storage` around a gap of `count` elements at `idx`,
+		// leaving [beg_, end_) without live elements; the old storage is still owned
+		CONSTEXPR auto relocate_to_(pointer new_storage, size_type idx, size_type count) ->void {
+			auto where_ = beg_ + idx;
+			if constexpr (relocatable_) {
+				if (!std::is_constant_evaluated()) {
+					detail::trivially_relocate(std::to_address(beg_), std::to_address(where_), std::to_address(new_storage));
+					detail::trivially_relocate(std::to_address(where_), std::to_address(end_), std::to_address(new_storage + idx + count));
+					return;
+				}
+			}
+			auto mid_ = this->transfer_(beg_, where_, new_storage);
+			try {
+				(void) this->transfer_(where_, end_, new_storage + idx + count);
+			}
+			catch (...) {
+				detail::alloc_destroy(new_storage, mid_, alloc_);
+				throw;
+			}
+			detail::alloc_destroy(beg_, end_, alloc_);
+		}
+
+		CONSTEXPR auto realloc_(size_type new_capacity) ->void { // assume: new_capacity >= size()
+			if constexpr (reallocatable_) {
+				if (!std::is_constant_evaluated() && this->on_heap_() && (N == 0 || new_capacity > N)) { // the allocator grows the buffer in place or moves its bytes for us
+					auto size_ = size();
+					auto [new_storage, allocated] = alloc_.reallocate(beg_, capacity(), new_capacity);
+					beg_ = new_storage;
+					end_ = beg_ + size_;
+					cap_ = beg_ + allocated;
+					return;
+				}
+			}
+			(void) this->realloc_insert_(new_capacity, size(), 0, [](pointer) {});
+		}
+
+		// moves the elements into a new storage of `new_capacity`, leaving a gap of `count` elements at `idx`
+		// which `construct_gap` fills in first (it must clean up after itself if it throws)
+		template<typename ConstructGap>
+		CONSTEXPR auto realloc_insert_(size_type new_capacity, size_type idx, size_type count, ConstructGap construct_gap) ->iterator { // assume: new_capacity >= size() + count
+			auto [new_storage, allocated] = this->allocate_(new_capacity); // keep whatever extra the allocator hands out
+			new_capacity = allocated;
+			auto size_ = size();
+
+			try {
+				construct_gap(new_storage + idx);
+			}
+			catch (...) {
+				this->deallocate_(new_storage, new_capacity);
+				throw;
+			}
+
+			try {
+				this->relocate_to_(new_storage, idx, count);
+			}
+			catch (...) {
+				detail::alloc_destroy(new_storage + idx, new_storage + idx + count, alloc_);
+				this->deallocate_(new_storage, new_capacity);
+				throw;
+			}
+
+			this->deallocate_(beg_, capacity());
+
+			beg_ = new_storage;
+			end_ = beg_ + (size_ + count);
+			cap_ = beg_ + new_capacity;
+			return beg_ + idx;
+		}
+
+		template<typename ConstructRange>
+		CONSTEXPR auto resize_impl_(size_type new_size, ConstructRange construct_range) ->void {
+			if (new_size < size()) {
+				this->erase(cbegin() + new_size, cend());
+			}
+			else if (new_size <= capacity()) {
+				construct_range(end_, beg_ + new_size);
+				end_ = beg_ + new_size;
+			}
+			else {
+				auto count = new_size - size();
+				this->realloc_insert_(this->grow_(new_size), size(), count, [&](pointer gap) {
+					construct_range(gap, gap + count);
+				});
+			}
+		}
+	private:
+		static constexpr bool relocatable_ = concepts::trivially_relocatable_into<value_type, vector_base>;
+		static constexpr bool reallocatable_ = concepts::reallocatable_into<value_type, vector_base>;
+	protected:
+		union inline_storage_ {
+			CONSTEXPR inline_storage_() noexcept {}
+			CONSTEXPR ~inline_storage_() {}
+			value_type elems_[N > 0 ? N : 1];
+		};
+
+		struct no_inline_storage_ {};
+
+		pointer beg_{inline_data_()}, end_{beg_}, cap_{beg_ + N};
+		allocator_type alloc_{};
+		[[no_unique_address]] std::conditional_t<(N > 0), inline_storage_, no_inline_storage_> inline_;
+	};
+}
\ No newline at end of file
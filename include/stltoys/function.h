@@ -1,19 +1,151 @@
 #pragma once
+#include <cstddef>
+#include <cstring>
 #include <type_traits>
 #include <functional>
+#include <memory>
+#include <new>
 #include <utility>
 
 namespace ccat {
 
+    namespace detail {
+        template<class R, class F, class... Args> requires std::is_invocable_r_v<R, F, Args...>
+        constexpr auto invoke_r(F&& f, Args&&... args) noexcept(std::is_nothrow_invocable_r_v<R, F, Args...>) ->R {
+            if constexpr (std::is_void_v<R>) std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+            else return std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+        }
+
+        template<typename Fn, typename Alloc>
+        struct allocated_target_ { // `Fn` at the start of one block from `Alloc`, followed by the copy of `Alloc` that frees it
+            static constexpr std::size_t alloc_offset = (sizeof(Fn) + alignof(Alloc) - 1) / alignof(Alloc) * alignof(Alloc);
+
+            struct alignas(Fn) alignas(Alloc) block {
+                std::byte raw[alloc_offset + sizeof(Alloc)];
+            };
+
+            using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<block>;
+            using block_traits = std::allocator_traits<block_allocator>;
+
+            template<typename F>
+            static auto create(const Alloc& alloc, F&& fn) ->void* {
+                block_allocator block_alloc(alloc);
+                auto raw = std::to_address(block_traits::allocate(block_alloc, 1))->raw;
+                try {
+                    ::new (static_cast<void*>(raw)) Fn(std::forward<F>(fn));
+                }
+                catch (...) {
+                    block_traits::deallocate(block_alloc, reinterpret_cast<block*>(raw), 1);
+                    throw;
+                }
+                ::new (static_cast<void*>(raw + alloc_offset)) Alloc(alloc);
+                return raw;
+            }
+
+            static auto copy(void* p) ->void* {
+                auto& alloc = allocator_of(p);
+                return create(std::allocator_traits<Alloc>::select_on_container_copy_construction(alloc), *static_cast<const Fn*>(p));
+            }
+
+            static auto destroy(void* p) noexcept ->void {
+                auto& alloc = allocator_of(p);
+                block_allocator block_alloc(alloc);
+                std::launder(static_cast<Fn*>(p))->~Fn();
+                alloc.~Alloc();
+                block_traits::deallocate(block_alloc, reinterpret_cast<block*>(p), 1);
+            }
+
+            static auto allocator_of(void* p) noexcept ->Alloc& {
+                return *std::launder(reinterpret_cast<Alloc*>(static_cast<std::byte*>(p) + alloc_offset));
+            }
+        };
+
+        union function_storage_ { // room for a callable of up to two pointers; bigger ones live on the heap behind `ptr`
+            void* ptr;
+            alignas(void*) std::byte buf[2 * sizeof(void*)];
+        };
+
+        template<typename Fn> // only nothrow-movable callables go inline, so moving a function never throws
+        inline constexpr bool stored_inline_ = sizeof(Fn) <= sizeof(function_storage_) && alignof(function_storage_) % alignof(Fn) == 0 && std::is_nothrow_move_constructible_v<Fn>;
+
+        template<typename R, typename... Args>
+        struct function_ops_ { // what a function knows about its target, one static table per target type
+            void (*destroy)(function_storage_&) noexcept;
+            void (*copy)(const function_storage_&, function_storage_&);
+            void (*move)(function_storage_&, function_storage_&) noexcept; // null when copying the bytes will do
+            R (*invoke)(const function_storage_&, Args...);
+            auto (*type)() noexcept ->const std::type_info&;
+        };
+
+        struct move_only_fn_ops_ { // a move-only target's lifetime; its invoker lives in the object itself
+            void (*destroy)(function_storage_&) noexcept;
+            void (*move)(function_storage_&, function_storage_&) noexcept; // null when copying the bytes will do
+        };
+
+        template<typename Fn, typename Alloc = void> // `Alloc` is `void` for heap targets from `new`
+        struct function_manager_ {
+            static constexpr bool relocatable = !stored_inline_<Fn> || std::is_trivially_copyable_v<Fn>;
+
+            template<typename... CArgs>
+            static auto emplace(function_storage_& dest, CArgs&&... args) ->void {
+                if constexpr (stored_inline_<Fn>) ::new (static_cast<void*>(dest.buf)) Fn(std::forward<CArgs>(args)...);
+                else dest.ptr = new Fn(std::forward<CArgs>(args)...);
+            }
+
+            template<typename F>
+            static auto create(function_storage_& dest, F&& fn, const Alloc* alloc = nullptr) ->void {
+                if constexpr (stored_inline_<Fn> || std::is_void_v<Alloc>) emplace(dest, std::forward<F>(fn));
+                else dest.ptr = allocated_target_<Fn, Alloc>::create(*alloc, std::forward<F>(fn));
+            }
+
+            static auto copy(const function_storage_& src, function_storage_& dest) ->void {
+                if constexpr (stored_inline_<Fn>) ::new (static_cast<void*>(dest.buf)) Fn(*target(src));
+                else if constexpr (std::is_void_v<Alloc>) dest.ptr = new Fn(*target(src));
+                else dest.ptr = allocated_target_<Fn, Alloc>::copy(src.ptr);
+            }
+
+            static auto move(function_storage_& src, function_storage_& dest) noexcept ->void { // leaves nothing to destroy in `src`
+                if constexpr (stored_inline_<Fn>) {
+                    ::new (static_cast<void*>(dest.buf)) Fn(std::move(*target(src)));
+                    target(src)->~Fn();
+                }
+                else dest.ptr = src.ptr;
+            }
+
+            static auto destroy(function_storage_& s) noexcept ->void {
+                if constexpr (stored_inline_<Fn>) target(s)->~Fn();
+                else if constexpr (std::is_void_v<Alloc>) delete target(s);
+                else allocated_target_<Fn, Alloc>::destroy(s.ptr);
+            }
+
+            template<typename R, typename... Args>
+            static auto invoke(const function_storage_& s, Args... args) ->R {
+                return invoke_r<R>(*target(s), std::forward<Args>(args)...);
+            }
+
+            static auto target(const function_storage_& s) noexcept ->Fn* {
+                if constexpr (stored_inline_<Fn>) return std::launder(reinterpret_cast<Fn*>(const_cast<std::byte*>(s.buf)));
+                else return static_cast<Fn*>(s.ptr);
+            }
+
+            static auto type() noexcept ->const std::type_info& {
+                return typeid(Fn);
+            }
+
+            template<typename R, typename... Args>
+            static constexpr function_ops_<R, Args...> ops{&destroy, &copy, relocatable ? nullptr : &move, &invoke<R, Args...>, &type};
+
+            static constexpr move_only_fn_ops_ move_only_ops{&destroy, relocatable ? nullptr : &move};
+        };
+    }
+
 	template<typename T>
     class function;
 
     template<typename R, typename... Args>
     class function<R(Args...)> {
-        using pointer = void*;
-        using on_destroy = void(*)(pointer);
-        using on_copy = pointer(*)(pointer);
-        using on_invoke = R(*)(pointer, Args...);
+        using storage = detail::function_storage_;
+        using ops_type = detail::function_ops_<R, Args...>;
     public:
         using result_type = R;
     public:
@@ -21,74 +153,76 @@ namespace ccat {
 
         function(std::nullptr_t) noexcept : function() {}
 
-        function(const function& other) : ptr(other ? other.on_copy_(other.ptr) : nullptr), on_destroy_(other.on_destroy_), on_copy_(other.on_copy_), on_invoke_(other.on_invoke_), target_type_(other.target_type_) {}
+        function(const function& other) {
+            if (other.ops_) other.ops_->copy(other.storage_, storage_);
+            ops_ = other.ops_;
+        }
 
-        function(function&& other) noexcept : ptr(std::exchange(other.ptr, {})), on_destroy_(std::exchange(other.on_destroy_, {})), on_copy_(std::exchange(other.on_copy_, {})), on_invoke_(std::exchange(other.on_invoke_, {})), target_type_(std::exchange(other.target_type_, typeid(void))) {}
+        function(function&& other) noexcept {
+            take_(other);
+        }
 
         template<typename Fn> requires (!std::same_as<std::remove_cvref_t<Fn>, function>) && std::is_invocable_r_v<R, Fn, Args...> && std::copy_constructible<std::decay_t<Fn>>
-        function(Fn&& fn) :
-            ptr(new auto(std::forward<Fn>(fn))),
-            on_destroy_(+[](void* ping) ->void {
-                auto pong = static_cast<std::decay_t<Fn>*>(ping);
-                delete pong;
-            }),
-            on_copy_(+[](void* ping) ->pointer {
-                auto pong = static_cast<std::decay_t<Fn>*>(ping);
-                return new auto(*pong);
-            }),
-            on_invoke_(+[](void* ping, Args... args) ->R {
-                auto pong = static_cast<std::decay_t<Fn>*>(ping);
-                return std::invoke(*pong, std::forward<Args>(args)...);
-            }),
-            target_type_(typeid(fn)) {}
+        function(Fn&& fn) {
+            detail::function_manager_<std::decay_t<Fn>>::create(storage_, std::forward<Fn>(fn));
+            ops_ = &detail::function_manager_<std::decay_t<Fn>>::template ops<R, Args...>;
+        }
+
+        template<typename Alloc, typename Fn> requires (!std::same_as<std::remove_cvref_t<Fn>, function>) && std::is_invocable_r_v<R, Fn, Args...> && std::copy_constructible<std::decay_t<Fn>>
+        function(std::allocator_arg_t, const Alloc& alloc, Fn&& fn) { // a target too big for the inline buffer lives in memory from `alloc`, and so do its copies
+            detail::function_manager_<std::decay_t<Fn>, Alloc>::create(storage_, std::forward<Fn>(fn), std::addressof(alloc));
+            ops_ = &detail::function_manager_<std::decay_t<Fn>, Alloc>::template ops<R, Args...>;
+        }
 
         ~function() {
-            if (on_destroy_) on_destroy_(ptr);
+            if (ops_) ops_->destroy(storage_);
         }
 
         auto operator= (std::nullptr_t) noexcept ->function& {
-            function(nullptr).swap(*this);
+            reset_();
             return *this;
         }
 
         auto operator= (const function& other) ->function& {
-            function(other).swap(*this);
+            *this = function(other);
             return *this;
         }
 
         auto operator= (function&& other) noexcept ->function& {
-            function(std::move(other)).swap(*this);
+            if (this != std::addressof(other)) {
+                reset_();
+                take_(other);
+            }
             return *this;
         }
 
         template<typename Fn> requires (!std::same_as<std::remove_cvref_t<Fn>, function>) && std::is_invocable_r_v<R, Fn, Args...> && std::copy_constructible<std::decay_t<Fn>>
         auto operator= (Fn&& fn) ->function& {
-            function(std::forward<Fn>(fn)).swap(*this);
+            *this = function(std::forward<Fn>(fn));
             return *this;
         }
 
         template<typename Fn>
         auto operator= (std::reference_wrapper<Fn> fn) noexcept ->function& {
-            function(fn).swap(*this);
+            *this = function(fn);
             return *this;
         }
 
         auto operator() (Args... args) const ->R {
-            if (on_invoke_ == nullptr) throw std::bad_function_call{};
-            return on_invoke_(ptr, std::forward<Args>(args)...);
+            if (ops_ == nullptr) throw std::bad_function_call{};
+            return ops_->invoke(storage_, std::forward<Args>(args)...);
         }
 
         [[nodiscard]]
         explicit operator bool() const noexcept {
-            return bool(ptr);
+            return ops_ != nullptr;
         }
 
         auto swap(function& other) noexcept ->void {
-            std::ranges::swap(ptr, other.ptr);
-            std::ranges::swap(on_destroy_, other.on_destroy_);
-            std::ranges::swap(on_copy_, other.on_copy_);
-            std::ranges::swap(on_invoke_, other.on_invoke_);
-            std::ranges::swap(target_type_, other.target_type_);
+            if (this == std::addressof(other)) return;
+            function tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
         }
 
         friend auto swap(function& lhs, function& rhs) noexcept ->void {
@@ -96,29 +230,39 @@ namespace ccat {
         }
 
         auto target_type() const noexcept ->const std::type_info& {
-            return target_type_;
+            return ops_ ? ops_->type() : typeid(void);
         }
 
         template<typename T>
         auto target() noexcept ->T* {
-            return target_type() == typeid(T) ? static_cast<T*>(ptr) : nullptr;
+            return target_type() == typeid(T) ? detail::function_manager_<T>::target(storage_) : nullptr;
         }
 
         template<typename T>
         auto target() const noexcept ->const T* {
-            return target_type() == typeid(T) ? static_cast<const T*>(ptr) : nullptr;
+            return target_type() == typeid(T) ? detail::function_manager_<T>::target(storage_) : nullptr;
         }
 
         friend auto operator== (const function& f, std::nullptr_t) noexcept ->bool {
-            return bool(f);
+            return !f;
+        }
+
+    private:
+        auto reset_() noexcept ->void {
+            if (ops_) ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+
+        auto take_(function& other) noexcept ->void { // `*this` must be empty
+            if (!other) return;
+            if (other.ops_->move) other.ops_->move(other.storage_, storage_);
+            else std::memcpy(static_cast<void*>(&storage_), static_cast<const void*>(&other.storage_), sizeof(storage));
+            ops_ = std::exchange(other.ops_, nullptr);
         }
 
     private:
-        pointer                                      ptr          = nullptr;
-        on_destroy                                   on_destroy_  = nullptr;
-        on_copy                                      on_copy_     = nullptr;
-        on_invoke                                    on_invoke_   = nullptr;
-        std::reference_wrapper<const std::type_info> target_type_ = typeid(void);
+        const ops_type* ops_ = nullptr;
+        storage         storage_;
     };
 
     namespace detail {
@@ -178,161 +322,185 @@ namespace ccat {
     function(Fn fn) -> function<detail::operator_invoke_type_<decltype(&Fn::operator())>>;
 
     namespace detail {
-        template<class R, class F, class... Args> requires std::is_invocable_r_v<R, F, Args...>
-        constexpr auto invoke_r(F&& f, Args&&... args) noexcept(std::is_nothrow_invocable_r_v<R, F, Args...>) ->R {
-            if constexpr (std::is_void_v<R>) std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
-            else return std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
-        }
-
-        template<char Ref, bool Const, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_base;
-
-        template<bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_base<'N', false, NoThrow, R, Args...> {
-            virtual auto operator() (Args... args) noexcept(NoThrow) ->R = 0;
-            virtual ~move_only_fn_storage_base() = default;
-        };
-
-        template<bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_base<'N', true, NoThrow, R, Args...> {
-            virtual auto operator() (Args... args) const noexcept(NoThrow) ->R = 0;
-            virtual ~move_only_fn_storage_base() = default;
-        };
-
-        template<bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_base<'L', false, NoThrow, R, Args...> {
-            virtual auto operator() (Args... args) & noexcept(NoThrow) ->R = 0;
-            virtual ~move_only_fn_storage_base() = default;
+        template<typename R, typename... Args>
+        struct inplace_function_ops_ { // an inplace_function's target, one static table per target type
+            void (*destroy)(void*) noexcept;
+            void (*copy)(const void*, void*);
+            void (*move)(void*, void*) noexcept; // null when copying the bytes will do
+            R (*invoke)(const void*, Args...);
+            auto (*type)() noexcept ->const std::type_info&;
         };
 
-        template<bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_base<'L', true, NoThrow, R, Args...> {
-            virtual auto operator() (Args... args) const& noexcept(NoThrow) ->R = 0;
-            virtual ~move_only_fn_storage_base() = default;
-        };
-
-        template<bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_base<'R', false, NoThrow, R, Args...> {
-            virtual auto operator() (Args... args) && noexcept(NoThrow) ->R = 0;
-            virtual ~move_only_fn_storage_base() = default;
-        };
+        template<typename Fn>
+        struct inplace_manager_ {
+            static auto destroy(void* p) noexcept ->void {
+                target(p)->~Fn();
+            }
 
-        template<bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_base<'R', true, NoThrow, R, Args...> {
-            virtual auto operator() (Args... args) const&& noexcept(NoThrow) ->R = 0;
-            virtual ~move_only_fn_storage_base() = default;
-        };
+            static auto copy(const void* src, void* dest) ->void {
+                ::new (dest) Fn(*target(src));
+            }
 
-        template<typename F, char Ref, bool Const, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_t;
+            static auto move(void* src, void* dest) noexcept ->void {
+                ::new (dest) Fn(std::move(*target(src)));
+                target(src)->~Fn();
+            }
 
-        template<typename F, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_t<F, 'N', false, NoThrow, R, Args...> : move_only_fn_storage_base<'N', false, NoThrow, R, Args...> {
-            auto operator() (Args... args) noexcept(NoThrow) ->R override {
-                return invoke_r<R>(f, std::forward<Args>(args)...);
+            template<typename R, typename... Args>
+            static auto invoke(const void* p, Args... args) ->R {
+                return invoke_r<R>(*target(p), std::forward<Args>(args)...);
             }
-            move_only_fn_storage_t(const F& f_) : f(f_) {}
 
-            move_only_fn_storage_t(F&& f_) noexcept(std::is_nothrow_move_constructible_v<F>) : f(std::move(f_)) {}
+            static auto type() noexcept ->const std::type_info& {
+                return typeid(Fn);
+            }
 
-            template<typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, CArgs&&... args) : f(std::forward<CArgs>(args)...) {}
+            static auto target(const void* p) noexcept ->Fn* {
+                return std::launder(static_cast<Fn*>(const_cast<void*>(p)));
+            }
 
-            template<typename U, typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, std::initializer_list<U> il, CArgs&&... args) : f(il, std::forward<CArgs>(args)...) {}
-            F f;
+            template<typename R, typename... Args>
+            static constexpr inplace_function_ops_<R, Args...> ops{&destroy, &copy, std::is_trivially_copyable_v<Fn> ? nullptr : &move, &invoke<R, Args...>, &type};
         };
+    }
 
-        template<typename F, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_t<F, 'N', true, NoThrow, R, Args...> : move_only_fn_storage_base<'N', true, NoThrow, R, Args...>  {
-            auto operator() (Args... args) const noexcept(NoThrow) ->R override {
-                return invoke_r<R>(static_cast<const F&>(f), std::forward<Args>(args)...);
-            }
-            move_only_fn_storage_t(const F& f_) : f(f_) {}
+    // A `function` whose target always lives in `Capacity` bytes inside the object; a callable that does not fit
+    // is a compile error rather than a heap allocation.
+    template<typename T, std::size_t Capacity = 4 * sizeof(void*), std::size_t Alignment = alignof(std::max_align_t)>
+    class inplace_function;
 
-            move_only_fn_storage_t(F&& f_) noexcept(std::is_nothrow_move_constructible_v<F>) : f(std::move(f_)) {}
+    template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment>
+    class inplace_function<R(Args...), Capacity, Alignment> {
+        using ops_type = detail::inplace_function_ops_<R, Args...>;
 
-            template<typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, CArgs&&... args) : f(std::forward<CArgs>(args)...) {}
+        static_assert(Capacity > 0, "`ccat::inplace_function` needs room for at least one byte");
+    public:
+        using result_type = R;
 
-            template<typename U, typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, std::initializer_list<U> il, CArgs&&... args) : f(il, std::forward<CArgs>(args)...) {}
+        static constexpr std::size_t capacity = Capacity;
+        static constexpr std::size_t alignment = Alignment;
+    public:
+        inplace_function() = default;
 
-            F f;
-        };
+        inplace_function(std::nullptr_t) noexcept : inplace_function() {}
 
-        template<typename F, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_t<F, 'L', false, NoThrow, R, Args...> : move_only_fn_storage_base<'L', false, NoThrow, R, Args...> {
-            auto operator() (Args... args) & noexcept(NoThrow) ->R override {
-                return invoke_r<R>(f, std::forward<Args>(args)...);
-            }
-            move_only_fn_storage_t(const F& f_) : f(f_) {}
+        inplace_function(const inplace_function& other) {
+            if (other.ops_) other.ops_->copy(other.storage_, storage_);
+            ops_ = other.ops_;
+        }
+
+        inplace_function(inplace_function&& other) noexcept {
+            take_(other);
+        }
 
-            move_only_fn_storage_t(F&& f_) noexcept(std::is_nothrow_move_constructible_v<F>) : f(std::move(f_)) {}
+        template<typename Fn> requires (!std::same_as<std::remove_cvref_t<Fn>, inplace_function>) && std::is_invocable_r_v<R, Fn, Args...> && std::copy_constructible<std::decay_t<Fn>>
+        inplace_function(Fn&& fn) {
+            using target_type = std::decay_t<Fn>;
+            static_assert(sizeof(target_type) <= Capacity, "the callable must fit in the `Capacity` bytes of `ccat::inplace_function`");
+            static_assert(Alignment % alignof(target_type) == 0, "the callable must not be aligned more strictly than `Alignment`");
+            static_assert(std::is_nothrow_move_constructible_v<target_type>, "the callable must be nothrow move constructible, so that `ccat::inplace_function` moves without throwing");
+            ::new (static_cast<void*>(storage_)) target_type(std::forward<Fn>(fn));
+            ops_ = &detail::inplace_manager_<target_type>::template ops<R, Args...>;
+        }
 
-            template<typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, CArgs&&... args) : f(std::forward<CArgs>(args)...) {}
+        ~inplace_function() {
+            if (ops_) ops_->destroy(storage_);
+        }
 
-            template<typename U, typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, std::initializer_list<U> il, CArgs&&... args) : f(il, std::forward<CArgs>(args)...) {}
+        auto operator= (std::nullptr_t) noexcept ->inplace_function& {
+            reset_();
+            return *this;
+        }
 
-            F f;
-        };
+        auto operator= (const inplace_function& other) ->inplace_function& {
+            *this = inplace_function(other);
+            return *this;
+        }
 
-        template<typename F, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_t<F, 'L', true, NoThrow, R, Args...> : move_only_fn_storage_base<'L', true, NoThrow, R, Args...>  {
-            auto operator() (Args... args) const& noexcept(NoThrow) ->R override {
-                return invoke_r<R>(static_cast<const F&>(f), std::forward<Args>(args)...);
+        auto operator= (inplace_function&& other) noexcept ->inplace_function& {
+            if (this != std::addressof(other)) {
+                reset_();
+                take_(other);
             }
-            move_only_fn_storage_t(const F& f_) : f(f_) {}
+            return *this;
+        }
 
-            move_only_fn_storage_t(F&& f_) noexcept(std::is_nothrow_move_constructible_v<F>) : f(std::move(f_)) {}
+        template<typename Fn> requires (!std::same_as<std::remove_cvref_t<Fn>, inplace_function>) && std::is_invocable_r_v<R, Fn, Args...> && std::copy_constructible<std::decay_t<Fn>>
+        auto operator= (Fn&& fn) ->inplace_function& {
+            *this = inplace_function(std::forward<Fn>(fn));
+            return *this;
+        }
 
-            template<typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, CArgs&&... args) : f(std::forward<CArgs>(args)...) {}
+        template<typename Fn>
+        auto operator= (std::reference_wrapper<Fn> fn) noexcept ->inplace_function& {
+            *this = inplace_function(fn);
+            return *this;
+        }
 
-            template<typename U, typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, std::initializer_list<U> il, CArgs&&... args) : f(il, std::forward<CArgs>(args)...) {}
+        auto operator() (Args... args) const ->R {
+            if (ops_ == nullptr) throw std::bad_function_call{};
+            return ops_->invoke(storage_, std::forward<Args>(args)...);
+        }
 
-            F f;
-        };
+        [[nodiscard]]
+        explicit operator bool() const noexcept {
+            return ops_ != nullptr;
+        }
 
-        template<typename F, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_t<F, 'R', false, NoThrow, R, Args...> : move_only_fn_storage_base<'R', false, NoThrow, R, Args...> {
-            auto operator() (Args... args) && noexcept(NoThrow) ->R override {
-                return invoke_r<R>(static_cast<F&&>(f), std::forward<Args>(args)...);
-            }
-            move_only_fn_storage_t(const F& f_) : f(f_) {}
+        auto swap(inplace_function& other) noexcept ->void {
+            if (this == std::addressof(other)) return;
+            inplace_function tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
 
-            move_only_fn_storage_t(F&& f_) noexcept(std::is_nothrow_move_constructible_v<F>) : f(std::move(f_)) {}
+        friend auto swap(inplace_function& lhs, inplace_function& rhs) noexcept ->void {
+            lhs.swap(rhs);
+        }
 
-            template<typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, CArgs&&... args) : f(std::forward<CArgs>(args)...) {}
+        auto target_type() const noexcept ->const std::type_info& {
+            return ops_ ? ops_->type() : typeid(void);
+        }
 
-            template<typename U, typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, std::initializer_list<U> il, CArgs&&... args) : f(il, std::forward<CArgs>(args)...) {}
+        template<typename T>
+        auto target() noexcept ->T* {
+            return target_type() == typeid(T) ? detail::inplace_manager_<T>::target(storage_) : nullptr;
+        }
 
-            F f;
-        };
+        template<typename T>
+        auto target() const noexcept ->const T* {
+            return target_type() == typeid(T) ? detail::inplace_manager_<T>::target(storage_) : nullptr;
+        }
 
-        template<typename F, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_storage_t<F, 'R', true, NoThrow, R, Args...> : move_only_fn_storage_base<'R', true, NoThrow, R, Args...> {
-            auto operator() (Args... args) const&& noexcept(NoThrow) ->R override {
-                return invoke_r<R>(static_cast<const F&&>(f), std::forward<Args>(args)...);
-            }
-            move_only_fn_storage_t(const F& f_) : f(f_) {}
+        friend auto operator== (const inplace_function& f, std::nullptr_t) noexcept ->bool {
+            return !f;
+        }
 
-            move_only_fn_storage_t(F&& f_) noexcept(std::is_nothrow_move_constructible_v<F>) : f(std::move(f_)) {}
+    private:
+        auto reset_() noexcept ->void {
+            if (ops_) ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
 
-            template<typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, CArgs&&... args) : f(std::forward<CArgs>(args)...) {}
+        auto take_(inplace_function& other) noexcept ->void { // `*this` must be empty
+            if (!other) return;
+            if (other.ops_->move) other.ops_->move(other.storage_, storage_);
+            else std::memcpy(static_cast<void*>(storage_), static_cast<const void*>(other.storage_), Capacity);
+            ops_ = std::exchange(other.ops_, nullptr);
+        }
 
-            template<typename U, typename... CArgs>
-            move_only_fn_storage_t(std::in_place_t, std::initializer_list<U> il, CArgs&&... args) : f(il, std::forward<CArgs>(args)...) {}
+    private:
+        const ops_type*                  ops_ = nullptr;
+        alignas(Alignment) std::byte     storage_[Capacity];
+    };
 
-            F f;
-        };
+    template<typename R, typename... Args>
+    inplace_function(R(*)(Args...)) -> inplace_function<R(Args...)>;
+
+    template<typename Fn>
+    inplace_function(Fn fn) -> inplace_function<detail::operator_invoke_type_<decltype(&Fn::operator())>>;
 
+    namespace detail {
         template<typename F, char Ref, bool Const, bool NoThrow, typename U>
         struct is_callable_from : std::false_type {};
 
@@ -379,66 +547,113 @@ namespace ccat {
         };
 
         template<char Ref, bool Const, bool NoThrow, typename R, typename... Args>
-        struct move_only_fn_impl {
+        struct move_only_fn_impl { // `Ref` is 'N', 'L' or 'R' for no, `&` or `&&` ref-qualifier on the call operator
             using result_type = R;
+            using invoker_type = R(*)(const function_storage_&, Args...) noexcept(NoThrow);
 
             move_only_fn_impl() = default;
 
             move_only_fn_impl(std::nullptr_t) noexcept {}
 
             template<typename F> requires is_callable_from<F, Ref, Const, NoThrow, R(Args...)>::value
-            move_only_fn_impl(F&& f) : ptr(new move_only_fn_storage_t<std::decay_t<F>, Ref, Const, NoThrow, R, Args...>(std::forward<F>(f)))  {}
+            move_only_fn_impl(F&& f) {
+                if constexpr (std::is_pointer_v<std::decay_t<F>> || std::is_member_pointer_v<std::decay_t<F>>) {
+                    if (f == nullptr) return;
+                }
+                init_<std::decay_t<F>>(std::forward<F>(f));
+            }
 
-            template<typename T, typename... TArgs> requires is_callable_from<T, Ref, Const, NoThrow, R(Args...)>::value
-            explicit move_only_fn_impl(std::in_place_type_t<T>, TArgs&&... args) : ptr(new move_only_fn_storage_t<T, Ref, Const, NoThrow, R, Args...>(std::in_place, std::forward<Args>(args)...)) {}
+            template<typename T, typename... TArgs> requires is_callable_from<T, Ref, Const, NoThrow, R(Args...)>::value && std::is_constructible_v<T, TArgs...>
+            explicit move_only_fn_impl(std::in_place_type_t<T>, TArgs&&... args) {
+                init_<T>(std::forward<TArgs>(args)...);
+            }
 
-            template<typename T, typename U, typename... TArgs> requires is_callable_from<T, Ref, Const, NoThrow, R(Args...)>::value
-            explicit move_only_fn_impl(std::in_place_type_t<T>, std::initializer_list<U> il, TArgs&&... args) : ptr(new move_only_fn_storage_t<T, Ref, Const, NoThrow, R, Args...>(std::in_place, il, std::forward<Args>(args)...)) {}
+            template<typename T, typename U, typename... TArgs> requires is_callable_from<T, Ref, Const, NoThrow, R(Args...)>::value && std::is_constructible_v<T, std::initializer_list<U>&, TArgs...>
+            explicit move_only_fn_impl(std::in_place_type_t<T>, std::initializer_list<U> il, TArgs&&... args) {
+                init_<T>(il, std::forward<TArgs>(args)...);
+            }
 
             move_only_fn_impl(const move_only_fn_impl&) = delete;
 
-            move_only_fn_impl(move_only_fn_impl&& other) noexcept : ptr(std::exchange(other.ptr, {})) {}
+            move_only_fn_impl(move_only_fn_impl&& other) noexcept {
+                take_(other);
+            }
 
             ~move_only_fn_impl() noexcept {
-                delete ptr;
+                if (ops_) ops_->destroy(storage_);
             }
 
             auto operator= (const move_only_fn_impl& other) noexcept ->move_only_fn_impl& = delete;
 
             auto operator= (move_only_fn_impl&& other) noexcept ->move_only_fn_impl& {
-                ptr = std::exchange(other.ptr, {});
+                if (this != std::addressof(other)) {
+                    reset_();
+                    take_(other);
+                }
                 return *this;
             }
 
             auto operator= (std::nullptr_t) noexcept ->move_only_fn_impl& {
-                delete std::exchange(ptr, {});
+                reset_();
                 return *this;
             }
 
             template<typename F> requires (!std::derived_from<std::remove_cvref_t<F>, move_only_fn_impl>)
             auto operator= (F&& f) ->move_only_fn_impl& {
-                move_only_fn_impl tmp = std::forward<F>(f);
-                swap(tmp);
+                *this = move_only_fn_impl(std::forward<F>(f));
                 return *this;
             }
 
             friend auto operator== (const move_only_fn_impl& lhs, std::nullptr_t) noexcept ->bool {
-                return lhs.ptr == nullptr;
+                return lhs.invoke_ == nullptr;
             }
 
             explicit operator bool() const noexcept {
-                return ptr;
+                return invoke_ != nullptr;
             }
 
             auto swap(move_only_fn_impl& other) noexcept ->void {
-                std::swap(ptr, other.ptr);
+                if (this == std::addressof(other)) return;
+                move_only_fn_impl tmp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
             }
 
             friend auto swap(move_only_fn_impl& lhs, move_only_fn_impl& rhs) noexcept ->void {
                 lhs.swap(rhs);
             }
 
-            move_only_fn_storage_base<Ref, Const, NoThrow, R, Args...>* ptr = nullptr;
+            template<typename T>
+            static auto invoke_target_(const function_storage_& s, Args... args) noexcept(NoThrow) ->R {
+                using cv_type = std::conditional_t<Const, const T, T>;
+                using ref_type = std::conditional_t<Ref == 'R', cv_type&&, cv_type&>;
+                return invoke_r<R>(static_cast<ref_type>(*function_manager_<T>::target(s)), std::forward<Args>(args)...);
+            }
+
+            template<typename T, typename... CArgs>
+            auto init_(CArgs&&... args) ->void {
+                function_manager_<T>::emplace(storage_, std::forward<CArgs>(args)...);
+                ops_ = &function_manager_<T>::move_only_ops;
+                invoke_ = &invoke_target_<T>;
+            }
+
+            auto reset_() noexcept ->void {
+                if (ops_) ops_->destroy(storage_);
+                ops_ = nullptr;
+                invoke_ = nullptr;
+            }
+
+            auto take_(move_only_fn_impl& other) noexcept ->void { // `*this` must be empty
+                if (!other) return;
+                if (other.ops_->move) other.ops_->move(other.storage_, storage_);
+                else std::memcpy(static_cast<void*>(&storage_), static_cast<const void*>(&other.storage_), sizeof(storage_));
+                ops_ = std::exchange(other.ops_, nullptr);
+                invoke_ = std::exchange(other.invoke_, nullptr);
+            }
+
+            invoker_type             invoke_  = nullptr; // called directly, without a trip through `ops_`
+            const move_only_fn_ops_* ops_     = nullptr;
+            function_storage_        storage_;
         };
 
     }
@@ -454,7 +669,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) ->R {
-            return (*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -466,7 +681,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) noexcept ->R {
-            return (*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -478,7 +693,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) & ->R {
-            return (*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -490,7 +705,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) & noexcept ->R {
-            return (*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -502,7 +717,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) && ->R {
-            return std::move(*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -514,7 +729,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) && noexcept ->R {
-            return std::move(*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -526,7 +741,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) const ->R {
-            return (*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -538,7 +753,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) const noexcept ->R {
-            return (*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -550,7 +765,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) const& ->R {
-            return (*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -562,7 +777,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) const& noexcept ->R {
-            return (*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -574,7 +789,7 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) const && ->R {
-            return std::move(*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
         };
     };
 
@@ -586,7 +801,93 @@ namespace ccat {
         using base_type_::operator=;
 
         auto operator() (Args... args) const&& noexcept ->R {
-            return std::move(*this->ptr)(std::forward<Args>(args)...);
+            return this->invoke_(this->storage_, std::forward<Args>(args)...);
+        };
+    };
+
+    namespace detail {
+        union function_ref_target_ { // what a function_ref points at
+            void* obj;
+            void (*fn)();
+        };
+
+        template<bool Const, bool NoThrow, typename R, typename... Args>
+        class function_ref_impl { // refers to a callable it does not own; copies are as cheap as two pointers
+            template<typename T>
+            using cv_ = std::conditional_t<Const, const T, T>;
+
+            template<typename F>
+            static constexpr bool callable_ = NoThrow ? std::is_nothrow_invocable_r_v<R, F, Args...> : std::is_invocable_r_v<R, F, Args...>;
+        public:
+            using result_type = R;
+        public:
+            template<typename F> requires std::is_function_v<F> && callable_<F*>
+            function_ref_impl(F* f) noexcept : invoke_(&invoke_function_<F>) {
+                target_.fn = reinterpret_cast<void(*)()>(f);
+            }
+
+            template<typename F> requires (!std::derived_from<std::remove_cvref_t<F>, function_ref_impl>) && (!std::is_function_v<std::remove_reference_t<F>>) && (!std::is_member_pointer_v<std::remove_cvref_t<F>>) && callable_<cv_<std::remove_reference_t<F>>&>
+            function_ref_impl(F&& f) noexcept : invoke_(&invoke_object_<cv_<std::remove_reference_t<F>>>) {
+                target_.obj = const_cast<void*>(static_cast<const volatile void*>(std::addressof(f)));
+            }
+
+            template<typename T> requires (!std::derived_from<T, function_ref_impl>) && (!std::is_pointer_v<T>)
+            auto operator= (T) ->function_ref_impl& = delete; // would leave the reference dangling once the statement ends
+
+            auto operator() (Args... args) const noexcept(NoThrow) ->R {
+                return invoke_(target_, std::forward<Args>(args)...);
+            }
+        private:
+            template<typename F>
+            static auto invoke_function_(function_ref_target_ target, Args... args) noexcept(NoThrow) ->R {
+                return invoke_r<R>(reinterpret_cast<F*>(target.fn), std::forward<Args>(args)...);
+            }
+
+            template<typename T>
+            static auto invoke_object_(function_ref_target_ target, Args... args) noexcept(NoThrow) ->R {
+                return invoke_r<R>(*static_cast<T*>(target.obj), std::forward<Args>(args)...);
+            }
+        private:
+            R (*invoke_)(function_ref_target_, Args...) noexcept(NoThrow);
+            function_ref_target_ target_;
         };
+    }
+
+    template<typename... >
+    class function_ref;
+
+    template<typename R, typename... Args>
+    class function_ref<R(Args...)> : public detail::function_ref_impl<false, false, R, Args...> {
+        using base_type_ = detail::function_ref_impl<false, false, R, Args...>;
+    public:
+        using base_type_::base_type_;
+        using base_type_::operator=;
+    };
+
+    template<typename R, typename... Args>
+    class function_ref<R(Args...) noexcept> : public detail::function_ref_impl<false, true, R, Args...> {
+        using base_type_ = detail::function_ref_impl<false, true, R, Args...>;
+    public:
+        using base_type_::base_type_;
+        using base_type_::operator=;
+    };
+
+    template<typename R, typename... Args>
+    class function_ref<R(Args...) const> : public detail::function_ref_impl<true, false, R, Args...> {
+        using base_type_ = detail::function_ref_impl<true, false, R, Args...>;
+    public:
+        using base_type_::base_type_;
+        using base_type_::operator=;
+    };
+
+    template<typename R, typename... Args>
+    class function_ref<R(Args...) const noexcept> : public detail::function_ref_impl<true, true, R, Args...> {
+        using base_type_ = detail::function_ref_impl<true, true, R, Args...>;
+    public:
+        using base_type_::base_type_;
+        using base_type_::operator=;
     };
+
+    template<typename F> requires std::is_function_v<F>
+    function_ref(F*) -> function_ref<F>;
 }
\ No newline at end of file
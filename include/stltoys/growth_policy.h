@@ -0,0 +1,84 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <memory>
+#include "detail/config.h"
+
+// A growth policy decides the capacity a container reallocates to. `grow(capacity, required, alloc)` receives
+// the container's growth basis and the minimal capacity needed (both in elements of `Alloc::value_type`) and
+// returns a capacity no smaller than `required`. The basis is the current capacity for vector and small_vector,
+// and the current size for basic_string.
+
+namespace ccat::detail {
+	NODISCARD CONSTEXPR auto malloc_size_class(std::size_t bytes) noexcept ->std::size_t { // jemalloc-like size classes
+		if (bytes <= 16) return 16;
+		if (bytes <= 128) return (bytes + 15) & ~std::size_t{15};
+		std::size_t group = std::bit_floor(bytes - 1); // 4 classes per doubling: (group, 2 * group] in steps of group / 4
+		std::size_t step = group >> 2;
+		return (bytes + step - 1) / step * step;
+	}
+}
+
+namespace ccat::growth_policy {
+	struct one_and_half {
+		template<typename Alloc>
+		NODISCARD static CONSTEXPR auto grow(std::size_t capacity, std::size_t required, const Alloc&) noexcept ->std::size_t {
+			return std::max(required, capacity + (capacity >> 1));
+		}
+	};
+
+	struct doubling {
+		template<typename Alloc>
+		NODISCARD static CONSTEXPR auto grow(std::size_t capacity, std::size_t required, const Alloc&) noexcept ->std::size_t {
+			return std::max(required, capacity << 1);
+		}
+	};
+
+	template<std::size_t Increment>
+	struct fixed_increment {
+		static_assert(Increment > 0);
+
+		template<typename Alloc>
+		NODISCARD static CONSTEXPR auto grow(std::size_t capacity, std::size_t required, const Alloc&) noexcept ->std::size_t {
+			return std::max(required, capacity + Increment);
+		}
+	};
+
+	template<std::size_t PageSize = 4096>
+	struct page_rounded { // grows by 1.5x and, once the buffer spans a page, rounds it up to whole pages
+		static_assert(std::has_single_bit(PageSize));
+
+		template<typename Alloc>
+		NODISCARD static CONSTEXPR auto grow(std::size_t capacity, std::size_t required, const Alloc& alloc) noexcept ->std::size_t {
+			constexpr std::size_t elem_size = sizeof(typename std::allocator_traits<Alloc>::value_type);
+			auto wanted = one_and_half::grow(capacity, required, alloc);
+			auto bytes = wanted * elem_size;
+			if (bytes < PageSize) return wanted;
+			return ((bytes + PageSize - 1) & ~(PageSize - 1)) / elem_size;
+		}
+	};
+
+	// grows by 1.5x and then takes the whole block the allocator would hand out anyway: `alloc.usable_size(n)`
+	// if the allocator can tell, otherwise the size class a typical malloc rounds the request up to
+	struct size_class_rounded {
+		template<typename Alloc>
+		NODISCARD static CONSTEXPR auto grow(std::size_t capacity, std::size_t required, const Alloc& alloc) noexcept ->std::size_t {
+			constexpr std::size_t elem_size = sizeof(typename std::allocator_traits<Alloc>::value_type);
+			auto wanted = one_and_half::grow(capacity, required, alloc);
+			if constexpr (requires { { alloc.usable_size(wanted) } -> std::convertible_to<std::size_t>; }) {
+				return std::max<std::size_t>(wanted, alloc.usable_size(wanted));
+			}
+			else {
+				return detail::malloc_size_class(wanted * elem_size) / elem_size;
+			}
+		}
+	};
+}
+
+namespace ccat::concepts {
+	template<typename Policy, typename Alloc>
+	concept growth_policy_for = requires (std::size_t n, const Alloc& alloc) {
+		{ Policy::grow(n, n, alloc) } -> std::convertible_to<std::size_t>;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+#if !defined(__linux__)
+#error "ccat::mmap_allocator needs Linux `mremap`"
+#endif
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "detail/config.h"
+#include "detail/util.h"
+
+namespace ccat {
+	// Buffers of at least `Threshold` bytes are backed by anonymous mappings and `reallocate` grows them with `mremap`,
+	// which remaps the pages instead of copying them; smaller buffers come from `std::allocator`.
+	// `reallocate` moves raw bytes, so containers only call it for trivially relocatable elements.
+	template<typename T, std::size_t Threshold = (std::size_t{1} << 20)>
+	class mmap_allocator {
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_move_assignment = std::true_type;
+		using is_always_equal = std::true_type;
+
+		template<typename U>
+		struct rebind {
+			using other = mmap_allocator<U, Threshold>;
+		};
+	public:
+		mmap_allocator() = default;
+
+		template<typename U>
+		CONSTEXPR mmap_allocator(const mmap_allocator<U, Threshold>&) noexcept {}
+	public:
+		NODISCARD auto allocate(size_type n) ->T* {
+			return allocate_at_least(n).ptr;
+		}
+
+		NODISCARD auto allocate_at_least(size_type n) ->allocation_result<T*> {
+			if (!is_mapped_(n)) return {std::allocator<T>{}.allocate(n), n};
+			auto bytes = mapping_size_(n);
+			void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p == MAP_FAILED) throw std::bad_alloc{};
+			return {static_cast<T*>(p), mapped_count_(n, bytes)};
+		}
+
+		auto deallocate(T* p, size_type n) noexcept ->void {
+			if (!is_mapped_(n)) std::allocator<T>{}.deallocate(p, n);
+			else ::munmap(static_cast<void*>(p), mapping_size_(n));
+		}
+
+		// resizes the buffer `p` of `old_n` elements to hold at least `new_n`, moving the bytes of the first `min(old_n, new_n)` elements;
+		// `p` must not be used afterwards (the result may be the same address)
+		NODISCARD auto reallocate(T* p, size_type old_n, size_type new_n) ->allocation_result<T*> {
+			if (is_mapped_(old_n) && is_mapped_(new_n)) {
+				auto bytes = mapping_size_(new_n);
+				void* q = ::mremap(static_cast<void*>(p), mapping_size_(old_n), bytes, MREMAP_MAYMOVE);
+				if (q == MAP_FAILED) throw std::bad_alloc{};
+				return {static_cast<T*>(q), mapped_count_(new_n, bytes)};
+			}
+			auto result = allocate_at_least(new_n);
+			std::memcpy(static_cast<void*>(result.ptr), static_cast<const void*>(p), std::min(old_n, new_n) * sizeof(T));
+			deallocate(p, old_n);
+			return result;
+		}
+
+		friend CONSTEXPR auto operator== (const mmap_allocator&, const mmap_allocator&) noexcept ->bool = default;
+	private:
+		NODISCARD static auto page_size_() noexcept ->size_type {
+			static const auto size_ = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+			return size_;
+		}
+
+		NODISCARD static auto is_mapped_(size_type n) noexcept ->bool {
+			return n >= (Threshold + sizeof(T) - 1) / sizeof(T);
+		}
+
+		NODISCARD static auto mapping_size_(size_type n) noexcept ->size_type {
+			auto page = page_size_();
+			return (n * sizeof(T) + page - 1) / page * page;
+		}
+
+		NODISCARD static auto mapped_count_(size_type n, size_type bytes) noexcept ->size_type { // the whole mapping is usable as long as `deallocate` can recompute its size
+			auto count = bytes / sizeof(T);
+			return mapping_size_(count) == bytes ? count : n;
+		}
+	};
+}
\ No newline at end of file
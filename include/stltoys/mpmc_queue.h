@@ -0,0 +1,206 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include "detail/config.h"
+#include "detail/concepts.h"
+#include "detail/util.h"
+
+namespace ccat {
+	// A bounded queue for any number of producer and consumer threads. Every slot carries a sequence number telling
+	// whose turn it is: `pos` when a producer may fill it for position `pos`, `pos + 1` when a consumer may empty it.
+	// The `try_` operations claim a position only when its slot is ready; `push`, `emplace` and `pop` take a ticket
+	// unconditionally and sleep on the slot's sequence with `std::atomic::wait` until their turn comes. Each slot counts
+	// its sleepers, so publishing notifies only when someone waits and the `try_` operations never touch the wait pool.
+	// A claimed position must be filled or emptied no matter what, so elements are moved in and out with nothrow moves.
+	template<typename T, typename Alloc = std::allocator<T>> requires std::same_as<T, std::remove_cvref_t<T>> && std::same_as<T, typename Alloc::value_type> && concepts::erasable<T, Alloc> && std::is_nothrow_move_constructible_v<T>
+	class mpmc_queue {
+	public:
+		using value_type = T;
+		using allocator_type = Alloc;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+	public:
+		explicit mpmc_queue(size_type capacity, const allocator_type& alloc = allocator_type()) : alloc_(alloc) { // `capacity` is rounded up to a power of two
+			if (capacity == 0 || capacity > (size_type{1} << (std::numeric_limits<size_type>::digits - 2))) {
+				throw std::length_error{"in `ccat::mpmc_queue::mpmc_queue`: the parameter `capacity` is out of range"};
+			}
+			capacity_ = std::bit_ceil(capacity);
+			mask_ = capacity_ - 1;
+			slot_allocator_type slot_alloc(alloc_);
+			slots_ = std::allocator_traits<slot_allocator_type>::allocate(slot_alloc, capacity_);
+			for (size_type i = 0; i < capacity_; ++i) {
+				std::construct_at(std::to_address(slots_ + i), i);
+			}
+		}
+
+		mpmc_queue(const mpmc_queue&) = delete;
+
+		~mpmc_queue() {
+			auto head = head_.load(std::memory_order_relaxed);
+			auto tail = tail_.load(std::memory_order_relaxed);
+			for (; head != tail; ++head) {
+				std::allocator_traits<allocator_type>::destroy(alloc_, slots_[head & mask_].value());
+			}
+			slot_allocator_type slot_alloc(alloc_);
+			std::allocator_traits<slot_allocator_type>::deallocate(slot_alloc, slots_, capacity_);
+		}
+	public:
+		auto operator= (const mpmc_queue&) ->mpmc_queue& = delete;
+
+		template<typename... Args> requires concepts::emplace_constructible_from<value_type, mpmc_queue, Args...>
+		NODISCARD auto try_emplace(Args&&... args) ->bool {
+			if constexpr (!std::is_nothrow_constructible_v<value_type, Args&&...>) { // build it before claiming a position
+				return this->try_emplace(value_type(std::forward<Args>(args)...));
+			}
+			else {
+				auto pos = tail_.load(std::memory_order_relaxed);
+				while (true) {
+					auto& slot = slots_[pos & mask_];
+					auto diff = static_cast<std::ptrdiff_t>(slot.seq.load(std::memory_order_acquire) - pos);
+					if (diff == 0) {
+						if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+							this->fill_(slot, pos, std::forward<Args>(args)...);
+							return true;
+						}
+					}
+					else if (diff < 0) { // the slot still holds the element from the previous lap
+						return false;
+					}
+					else {
+						pos = tail_.load(std::memory_order_relaxed);
+					}
+				}
+			}
+		}
+
+		NODISCARD auto try_push(const value_type& value) ->bool requires concepts::copy_insertable_into<value_type, mpmc_queue> {
+			return this->try_emplace(value);
+		}
+
+		NODISCARD auto try_push(value_type&& value) ->bool requires concepts::move_insertable_into<value_type, mpmc_queue> {
+			return this->try_emplace(std::move(value));
+		}
+
+		NODISCARD auto try_pop(value_type& out) ->bool requires std::is_nothrow_move_assignable_v<value_type> {
+			auto pos = head_.load(std::memory_order_relaxed);
+			while (true) {
+				auto& slot = slots_[pos & mask_];
+				auto diff = static_cast<std::ptrdiff_t>(slot.seq.load(std::memory_order_acquire) - (pos + 1));
+				if (diff == 0) {
+					if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						this->drain_(slot, pos, out);
+						return true;
+					}
+				}
+				else if (diff < 0) { // nothing has been pushed to this position yet
+					return false;
+				}
+				else {
+					pos = head_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		template<typename... Args> requires concepts::emplace_constructible_from<value_type, mpmc_queue, Args...>
+		auto emplace(Args&&... args) ->void { // blocks while the queue is full
+			if constexpr (!std::is_nothrow_constructible_v<value_type, Args&&...>) { // build it before claiming a position
+				return this->emplace(value_type(std::forward<Args>(args)...));
+			}
+			else {
+				auto pos = tail_.fetch_add(1, std::memory_order_relaxed);
+				auto& slot = slots_[pos & mask_];
+				this->wait_for_(slot, pos);
+				this->fill_(slot, pos, std::forward<Args>(args)...);
+			}
+		}
+
+		auto push(const value_type& value) ->void requires concepts::copy_insertable_into<value_type, mpmc_queue> {
+			this->emplace(value);
+		}
+
+		auto push(value_type&& value) ->void requires concepts::move_insertable_into<value_type, mpmc_queue> {
+			this->emplace(std::move(value));
+		}
+
+		NODISCARD auto pop() ->value_type { // blocks while the queue is empty
+			auto pos = head_.fetch_add(1, std::memory_order_relaxed);
+			auto& slot = slots_[pos & mask_];
+			this->wait_for_(slot, pos + 1);
+			value_type value(std::move(*slot.value()));
+			std::allocator_traits<allocator_type>::destroy(alloc_, slot.value());
+			this->publish_(slot, pos + capacity_);
+			return value;
+		}
+
+		NODISCARD auto empty() const noexcept ->bool { // a snapshot
+			return size() == 0;
+		}
+
+		NODISCARD auto size() const noexcept ->size_type { // a snapshot; consumers blocked in `pop` count as negative and are clamped away
+			auto head = head_.load(std::memory_order_acquire);
+			auto tail = tail_.load(std::memory_order_acquire);
+			auto diff = static_cast<std::ptrdiff_t>(tail - head);
+			return diff > 0 ? static_cast<size_type>(diff) : 0;
+		}
+
+		NODISCARD auto capacity() const noexcept ->size_type {
+			return capacity_;
+		}
+
+		NODISCARD auto get_allocator() const noexcept ->allocator_type {
+			return alloc_;
+		}
+	private:
+		struct alignas(detail::cache_line_size) slot_type { // one slot per cache line, so that neighbouring positions do not contend
+			explicit slot_type(size_type init_seq) noexcept : seq(init_seq) {}
+
+			auto value() noexcept ->value_type* {
+				return std::launder(reinterpret_cast<value_type*>(storage));
+			}
+
+			std::atomic<size_type> seq;
+			std::atomic<std::uint32_t> waiters{0}; // threads asleep on `seq`, so that publishing skips the notify when there are none
+			alignas(value_type) unsigned char storage[sizeof(value_type)];
+		};
+
+		using slot_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<slot_type>;
+
+		static auto wait_for_(slot_type& slot, size_type turn) noexcept ->void {
+			for (auto seq = slot.seq.load(std::memory_order_acquire); seq != turn; seq = slot.seq.load(std::memory_order_acquire)) {
+				slot.waiters.fetch_add(1, std::memory_order_seq_cst); // pairs with `publish_`: either it sees us, or `wait` sees its store
+				slot.seq.wait(seq, std::memory_order_seq_cst);
+				slot.waiters.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		template<typename... Args>
+		auto fill_(slot_type& slot, size_type pos, Args&&... args) noexcept ->void {
+			std::allocator_traits<allocator_type>::construct(alloc_, slot.value(), std::forward<Args>(args)...);
+			this->publish_(slot, pos + 1);
+		}
+
+		auto drain_(slot_type& slot, size_type pos, value_type& out) noexcept ->void {
+			out = std::move(*slot.value());
+			std::allocator_traits<allocator_type>::destroy(alloc_, slot.value());
+			this->publish_(slot, pos + capacity_);
+		}
+
+		static auto publish_(slot_type& slot, size_type seq) noexcept ->void {
+			slot.seq.store(seq, std::memory_order_seq_cst);
+			if (slot.waiters.load(std::memory_order_seq_cst) != 0) slot.seq.notify_all();
+		}
+	private:
+		alignas(detail::cache_line_size) std::atomic<size_type> tail_{0}; // the next position to push
+		alignas(detail::cache_line_size) std::atomic<size_type> head_{0}; // the next position to pop
+		alignas(detail::cache_line_size) slot_type* slots_{};
+		size_type capacity_{};
+		size_type mask_{};
+		allocator_type alloc_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "detail/config.h"
+
+namespace ccat {
+	// Serves blocks of up to `max_block_size` bytes from power-of-two size classes; larger or over-aligned requests go
+	// straight to `operator new`. Every thread keeps a free list per size class and only touches the shared pool, under
+	// a lock, to fetch or give back a whole batch of blocks at a time. A thread's cached blocks return to the pool when
+	// the thread exits, or when the thread next claims a cache slot after the resource is destroyed; the pool's memory is
+	// freed once the resource and every thread cache holding its blocks are gone.
+	class pool_resource {
+	public:
+		using size_type = std::size_t;
+
+		static constexpr size_type min_block_size = 16;
+		static constexpr size_type max_block_size = 1024;
+	public:
+		pool_resource() : pool_(std::make_shared<shared_pool_>()) {}
+
+		pool_resource(const pool_resource&) = delete;
+
+		~pool_resource() {
+			pool_->retire(); // other threads drop their caches for it the next time they look for a free slot
+			if (auto cache = local_cache_(pool_.get(), false)) cache->release();
+		}
+	public:
+		auto operator= (const pool_resource&) ->pool_resource& = delete;
+
+		NODISCARD auto allocate(size_type bytes, size_type align = alignof(std::max_align_t)) ->void* {
+			if (bytes > max_block_size || align > alignof(std::max_align_t)) [[unlikely]] {
+				return ::operator new(bytes, std::align_val_t{align});
+			}
+			auto cls = size_class_(bytes);
+			auto cache = local_cache_(pool_.get(), true);
+			if (cache == nullptr) [[unlikely]] return pool_->allocate_uncached(cls);
+			auto& list = cache->lists[cls];
+			if (list.head == nullptr) [[unlikely]] pool_->refill(list, cls);
+			auto block = list.head;
+			list.head = block->next;
+			if (list.count != 0) --list.count;
+			return block;
+		}
+
+		auto deallocate(void* p, size_type bytes, size_type align = alignof(std::max_align_t)) noexcept ->void {
+			if (bytes > max_block_size || align > alignof(std::max_align_t)) [[unlikely]] {
+				::operator delete(p, bytes, std::align_val_t{align});
+				return;
+			}
+			auto cls = size_class_(bytes);
+			auto cache = local_cache_(pool_.get(), true);
+			if (cache == nullptr) [[unlikely]] return pool_->deallocate_uncached(static_cast<node_*>(p), cls);
+			auto& list = cache->lists[cls];
+			list.head = ::new (p) node_{list.head, nullptr};
+			if (++list.count >= 2 * batch_size_(cls)) [[unlikely]] pool_->give_back(list, cls);
+		}
+
+		NODISCARD static auto default_resource() noexcept ->pool_resource& { // never destroyed, so it outlives every static container
+			static auto* resource = new pool_resource;
+			return *resource;
+		}
+	private:
+		struct node_ {
+			node_* next;
+			node_* next_batch; // links whole batches in the shared pool
+		};
+
+		struct free_list_ {
+			node_* head = nullptr;
+			size_type count = 0; // a hint for when to give blocks back, never trusted for emptiness
+		};
+
+		static constexpr size_type class_count = std::bit_width(max_block_size) - std::bit_width(min_block_size) + 1;
+		static constexpr size_type slab_size = size_type{1} << 16;
+
+		NODISCARD static auto size_class_(size_type bytes) noexcept ->size_type {
+			return bytes <= min_block_size ? 0 : std::bit_width(bytes - 1) - std::bit_width(min_block_size - 1);
+		}
+
+		NODISCARD static constexpr auto block_size_(size_type cls) noexcept ->size_type {
+			return min_block_size << cls;
+		}
+
+		NODISCARD static constexpr auto batch_size_(size_type cls) noexcept ->size_type {
+			return std::max<size_type>(8, 4096 / block_size_(cls));
+		}
+
+		class shared_pool_ {
+		public:
+			shared_pool_() = default;
+
+			shared_pool_(const shared_pool_&) = delete;
+
+			~shared_pool_() {
+				for (auto slab : slabs_) ::operator delete(slab, slab_size);
+			}
+
+			auto retire() noexcept ->void {
+				alive_.store(false, std::memory_order_release);
+			}
+
+			NODISCARD auto alive() const noexcept ->bool {
+				return alive_.load(std::memory_order_acquire);
+			}
+
+			auto refill(free_list_& list, size_type cls) ->void {
+				{
+					std::lock_guard lock{mutex_};
+					if (auto batch = batches_[cls]) {
+						batches_[cls] = batch->next_batch;
+						list.head = batch;
+						list.count = batch_size_(cls);
+						return;
+					}
+				}
+				auto slab = static_cast<std::byte*>(::operator new(slab_size)); // carved outside the lock
+				{
+					std::lock_guard lock{mutex_};
+					slabs_.push_back(slab);
+				}
+				auto size = block_size_(cls);
+				auto batch = batch_size_(cls);
+				auto count = slab_size / size;
+				node_* head = nullptr;
+				node_* batches = nullptr; // every full batch after the first, for the shared pool
+				node_* last_batch = nullptr;
+				for (auto i = count; i != 0; --i) {
+					head = ::new (slab + (i - 1) * size) node_{(i % batch == 0) ? nullptr : head, nullptr};
+					if ((i - 1) % batch == 0 && i - 1 != 0) {
+						head->next_batch = batches;
+						if (batches == nullptr) last_batch = head;
+						batches = head;
+					}
+				}
+				if (batches != nullptr) {
+					std::lock_guard lock{mutex_};
+					last_batch->next_batch = batches_[cls];
+					batches_[cls] = batches;
+				}
+				list.head = head;
+				list.count = std::min(batch, count);
+			}
+
+			auto give_back(free_list_& list, size_type cls) noexcept ->void { // hands the first batch of `list` to the pool
+				auto batch = list.head;
+				auto tail = batch;
+				for (auto i = batch_size_(cls); i > 1 && tail->next != nullptr; --i) tail = tail->next;
+				list.head = tail->next;
+				list.count = list.count > batch_size_(cls) ? list.count - batch_size_(cls) : 0;
+				tail->next = nullptr;
+				push_batch_(batch, cls);
+			}
+
+			auto flush(free_list_ (&lists)[class_count]) noexcept ->void {
+				for (size_type cls = 0; cls < class_count; ++cls) {
+					while (lists[cls].head != nullptr) give_back(lists[cls], cls);
+				}
+			}
+
+			NODISCARD auto allocate_uncached(size_type cls) ->void* {
+				free_list_ list;
+				refill(list, cls);
+				auto block = list.head;
+				list.head = block->next;
+				if (list.head != nullptr) push_batch_(list.head, cls);
+				return block;
+			}
+
+			auto deallocate_uncached(node_* block, size_type cls) noexcept ->void {
+				::new (static_cast<void*>(block)) node_{nullptr, nullptr};
+				push_batch_(block, cls);
+			}
+		private:
+			auto push_batch_(node_* batch, size_type cls) noexcept ->void {
+				std::lock_guard lock{mutex_};
+				batch->next_batch = batches_[cls];
+				batches_[cls] = batch;
+			}
+		private:
+			std::mutex mutex_;
+			node_* batches_[class_count]{};
+			std::vector<void*> slabs_;
+			std::atomic<bool> alive_{true}; // false once the owning resource is destroyed
+		};
+
+		struct thread_cache_ {
+			auto release() noexcept ->void {
+				if (owner != nullptr) owner->flush(lists);
+				owner.reset();
+			}
+
+			std::shared_ptr<shared_pool_> owner;
+			free_list_ lists[class_count]{};
+		};
+
+		static constexpr size_type caches_per_thread = 4; // resources beyond this many per thread go to the shared pool directly
+
+		struct thread_caches_ {
+			thread_caches_() = default;
+
+			thread_caches_(const thread_caches_&) = delete;
+
+			~thread_caches_() {
+				thread_exited_() = true;
+				for (auto& cache : slots) cache.release();
+			}
+
+			thread_cache_ slots[caches_per_thread];
+			thread_cache_* last = nullptr;
+		};
+
+		NODISCARD static auto thread_exited_() noexcept ->bool& { // trivially destructible, so other thread-locals can still ask while being destroyed
+			thread_local bool exited = false;
+			return exited;
+		}
+
+		// the calling thread's cache for `pool`, claimed on first use; null when the thread has no free slot left
+		NODISCARD auto local_cache_(shared_pool_* pool, bool claim) const noexcept ->thread_cache_* {
+			if (thread_exited_()) [[unlikely]] return nullptr;
+			thread_local thread_caches_ caches;
+			if (caches.last != nullptr && caches.last->owner.get() == pool) [[likely]] return caches.last;
+			for (auto& cache : caches.slots) {
+				if (cache.owner.get() == pool) return caches.last = &cache;
+			}
+			if (!claim) return nullptr;
+			for (auto& cache : caches.slots) {
+				if (cache.owner != nullptr && !cache.owner->alive()) cache.release(); // its resource is gone, so free the slot and let the pool die
+			}
+			for (auto& cache : caches.slots) {
+				if (cache.owner == nullptr) {
+					cache.owner = pool_;
+					return caches.last = &cache;
+				}
+			}
+			return nullptr;
+		}
+	private:
+		std::shared_ptr<shared_pool_> pool_;
+	};
+
+	// Allocates from a `pool_resource`, the process-wide `pool_resource::default_resource()` unless told otherwise.
+	// Containers keep their allocator on copy assignment and take the other one along on move assignment and swap.
+	template<typename T>
+	class pool_allocator {
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+	public:
+		pool_allocator() noexcept : resource_(std::addressof(pool_resource::default_resource())) {}
+
+		pool_allocator(pool_resource& resource) noexcept : resource_(std::addressof(resource)) {}
+
+		template<typename U>
+		pool_allocator(const pool_allocator<U>& other) noexcept : resource_(other.resource()) {}
+	public:
+		NODISCARD auto allocate(size_type n) ->T* {
+			if (n > std::numeric_limits<size_type>::max() / sizeof(T)) throw std::bad_array_new_length{};
+			return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		auto deallocate(T* p, size_type n) noexcept ->void {
+			resource_->deallocate(static_cast<void*>(p), n * sizeof(T), alignof(T));
+		}
+
+		NODISCARD auto resource() const noexcept ->pool_resource* {
+			return resource_;
+		}
+
+		template<typename U>
+		friend auto operator== (const pool_allocator& lhs, const pool_allocator<U>& rhs) noexcept ->bool {
+			return lhs.resource_ == rhs.resource();
+		}
+	private:
+		pool_resource* resource_;
+	};
+}
\ No newline at end of file
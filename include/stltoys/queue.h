@@ -2,7 +2,7 @@
 #include "deque.h"
 
 namespace ccat {
-	template<typename T, typename Container>
+	template<typename T, typename Container = deque<T>>
 	class queue {
 	public:
 		using container_type = Container;
@@ -45,19 +45,19 @@ namespace ccat {
 		queue(from_range_t, Range&& rng, const Alloc& alloc) : container_(from_range, std::forward<Range>(rng), alloc) {}
 
 		NODISCARD auto front() noexcept(noexcept(std::declval<container_type&>().front())) ->reference {
-			container_.front();
+			return container_.front();
 		}
 
 		NODISCARD auto front() const noexcept(noexcept(std::declval<const container_type&>().front())) ->const_reference {
-			container_.front();
+			return container_.front();
 		}
 
 		NODISCARD auto back() noexcept(noexcept(std::declval<container_type&>().back())) ->reference {
-			container_.back();
+			return container_.back();
 		}
 
 		NODISCARD auto back() const noexcept(noexcept(std::declval<const container_type&>().back())) ->const_reference {
-			container_.back();
+			return container_.back();
 		}
 
 		auto push(const value_type& value) ->void {
@@ -124,25 +124,25 @@ namespace ccat {
 			return lhs.container_ <= rhs.container_;
 		}
 
-		friend auto operator<=> (const queue& lhs, const queue& rhs) requires std::three_way_comparable<container_type> ->std::compare_three_way_result_t<container_type> {
+		friend auto operator<=> (const queue& lhs, const queue& rhs) ->std::compare_three_way_result_t<container_type> requires std::three_way_comparable<container_type> {
 			return lhs.container_ <=> rhs.container_;
 		}
 
-		template<typename Container>
-		queue(Container) -> queue<typename Container::value_type, Container>;
+	private:
+		container_type container_;
+	};
 
-		template<typename Container, typename Alloc>
-		queue(Container, Alloc) -> queue<typename Container::value_type, Container>;
+	template<typename Container>
+	queue(Container) -> queue<typename Container::value_type, Container>;
 
-		template<std::input_iterator InputIt>
-		queue(InputIt, InputIt) -> queue<typename std::iterator_traits<InputIt>::value_type>;
+	template<typename Container, typename Alloc>
+	queue(Container, Alloc) -> queue<typename Container::value_type, Container>;
 
-		template<std::ranges::input_range R>
-		queue(from_range_t, R&&) -> queue<std::ranges::range_value_t<R>>;
+	template<std::input_iterator InputIt>
+	queue(InputIt, InputIt) -> queue<typename std::iterator_traits<InputIt>::value_type>;
 
-	private:
-		container_type container_;
-	};
+	template<std::ranges::input_range R>
+	queue(from_range_t, R&&) -> queue<std::ranges::range_value_t<R>>;
 }
 
 template<typename T, typename Container, typename Alloc>
@@ -0,0 +1,194 @@
+#pragma once
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include "detail/config.h"
+#include "detail/iterator.h"
+#include "detail/concepts.h"
+#include "detail/vector_base.h"
+#include "growth_policy.h"
+
+namespace ccat {
+	// keeps up to `N` elements in an inline buffer and spills to the heap beyond that
+	template<typename T, std::size_t N, typename Alloc = std::allocator<T>, typename GrowthPolicy = growth_policy::one_and_half> requires std::same_as<T, std::remove_cvref_t<T>> && std::same_as<T, typename Alloc::value_type> && concepts::erasable<T, Alloc> && (N > 0) && std::is_pointer_v<typename std::allocator_traits<Alloc>::pointer> && concepts::growth_policy_for<GrowthPolicy, Alloc>
+	class small_vector : public detail::vector_base<T, Alloc, GrowthPolicy, N> {
+	private:
+		using base = detail::vector_base<T, Alloc, GrowthPolicy, N>;
+	public:
+		using value_type = T;
+		using allocator_type = Alloc;
+		using growth_policy_type = GrowthPolicy;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = typename std::allocator_traits<allocator_type>::pointer;
+		using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using iterator = detail::contiguous_iterator<true, value_type>;
+		using const_iterator = detail::contiguous_iterator<false, value_type>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	public:
+		static constexpr size_type inline_capacity = N;
+	public: // ctor and dtor
+
+		CONSTEXPR small_vector() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) {}
+
+		CONSTEXPR explicit small_vector(const allocator_type& alloc) noexcept : base(alloc) {}
+
+		CONSTEXPR small_vector(size_type count, const_reference value, const allocator_type& alloc = allocator_type()) : base(alloc) {
+			this->resize(count, value);
+		}
+
+		CONSTEXPR explicit small_vector(size_type count, const allocator_type& alloc = allocator_type()) : base(alloc) {
+			this->resize(count);
+		}
+
+		template<std::input_iterator InputIt>
+		CONSTEXPR small_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : base(alloc) {
+			(void) this->append_range_impl_(std::move(first), std::move(last));
+		}
+
+		CONSTEXPR small_vector(const small_vector& other) :
+			base(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
+		{
+			(void) this->append_n_(other.beg_, other.size());
+		}
+
+		CONSTEXPR small_vector(const small_vector& other, const allocator_type& alloc) : base(alloc) {
+			(void) this->append_n_(other.beg_, other.size());
+		}
+
+		CONSTEXPR small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>) : base(std::move(other.alloc_)) {
+			this->steal_(other);
+		}
+
+		CONSTEXPR small_vector(small_vector&& other, const allocator_type& alloc) : base(alloc) {
+			if (this->alloc_ == other.alloc_) {
+				this->steal_(other);
+			}
+			else {
+				(void) this->append_n_(std::make_move_iterator(other.beg_), other.size());
+				other.clear();
+			}
+		}
+
+		CONSTEXPR small_vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type()) : base(alloc) {
+			(void) this->append_n_(ilist.begin(), ilist.size());
+		}
+
+		template<std::ranges::input_range Range>
+		CONSTEXPR small_vector(from_range_t, Range&& rng, const allocator_type& alloc = allocator_type()) : base(alloc) {
+			this->append_range(std::forward<Range>(rng));
+		}
+	public:
+
+		CONSTEXPR auto operator= (const small_vector& other) ->small_vector& {
+			if (this == std::addressof(other)) [[unlikely]] return *this;
+			if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value) {
+				if (this->alloc_ != other.alloc_) this->die_();
+				this->alloc_ = other.alloc_;
+			}
+			this->assign_range(other);
+			return *this;
+		}
+
+		CONSTEXPR auto operator= (small_vector&& other) noexcept(
+			(std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value || std::allocator_traits<allocator_type>::is_always_equal::value) &&
+			std::is_nothrow_move_constructible_v<value_type>
+		) ->small_vector& {
+			if (this == std::addressof(other)) [[unlikely]] return *this;
+			if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+				this->die_();
+				this->alloc_ = std::move(other.alloc_);
+				this->steal_(other);
+			}
+			else {
+				if (this->alloc_ == other.alloc_) {
+					this->die_();
+					this->steal_(other);
+				}
+				else {
+					this->assign_range(std::ranges::subrange{std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())});
+					other.clear();
+				}
+			}
+			return *this;
+		}
+
+		CONSTEXPR auto operator= (std::initializer_list<value_type> ilist) ->small_vector& {
+			this->assign_range(ilist);
+			return *this;
+		}
+
+		CONSTEXPR auto assign(size_type count, const_reference value) ->void {
+			small_vector(count, value, this->alloc_).swap(*this);
+		}
+
+		template<std::input_iterator InputIt>
+		CONSTEXPR auto assign(InputIt first, InputIt last) ->void {
+			this->assign_range(std::ranges::subrange{std::move(first), std::move(last)});
+		}
+
+		CONSTEXPR auto assign(std::initializer_list<value_type> ilist) ->void {
+			*this = ilist;
+		}
+
+		NODISCARD CONSTEXPR auto at(size_type index) ->reference {
+			if (index >= this->size()) throw std::out_of_range{"in `ccat::small_vector::at`: the parameter `index` is out of range"};
+			return this->beg_[index];
+		}
+
+		NODISCARD CONSTEXPR auto at(size_type index) const ->const_reference {
+			if (index >= this->size()) throw std::out_of_range{"in `ccat::small_vector::at`: the parameter `index` is out of range"};
+			return this->beg_[index];
+		}
+
+		NODISCARD CONSTEXPR auto is_inline() const noexcept ->bool { // Cra3z extension
+			return !this->on_heap_();
+		}
+
+		CONSTEXPR auto shrink_to_fit() ->void requires concepts::move_insertable_into<value_type, small_vector> { // moves the elements back inline when they fit
+			if (is_inline() || this->size() == this->capacity()) return;
+			this->realloc_(this->size());
+		}
+
+		CONSTEXPR auto swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<value_type> && std::is_nothrow_move_assignable_v<value_type>) ->void { // undefined if propagate_on_container_swap::value is false and this->alloc_ not equal to other.alloc_
+			if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+				std::ranges::swap(this->alloc_, other.alloc_);
+			}
+			if (!is_inline() && !other.is_inline()) {
+				std::ranges::swap(this->beg_, other.beg_);
+				std::ranges::swap(this->end_, other.end_);
+				std::ranges::swap(this->cap_, other.cap_);
+				return;
+			}
+			small_vector& inline_one = is_inline() ? *this : other; // the other one may be inline too
+			small_vector& another = is_inline() ? other : *this;
+			small_vector tmp(this->alloc_);
+			tmp.steal_(inline_one);
+			inline_one.steal_(another);
+			another.steal_(tmp);
+		}
+
+		CONSTEXPR friend auto swap(small_vector& lhs, small_vector& rhs) noexcept(noexcept(lhs.swap(rhs))) ->void {
+			lhs.swap(rhs);
+		}
+	};
+
+	template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy, typename U> requires std::equality_comparable_with<T, U>
+	CONSTEXPR auto erase(small_vector<T, N, Alloc, GrowthPolicy>& c, const U& value) ->typename small_vector<T, N, Alloc, GrowthPolicy>::size_type {
+		auto it = std::remove(c.begin(), c.end(), value);
+		auto r = c.end() - it;
+		c.erase(it, c.end());
+		return r;
+	}
+
+	template<typename T, std::size_t N, typename Alloc, typename GrowthPolicy, typename Pred> requires std::predicate<Pred, T&>
+	CONSTEXPR auto erase_if(small_vector<T, N, Alloc, GrowthPolicy>& c, Pred pred) ->typename small_vector<T, N, Alloc, GrowthPolicy>::size_type {
+		auto it = std::remove_if(c.begin(), c.end(), pred);
+		auto r = c.end() - it;
+		c.erase(it, c.end());
+		return r;
+	}
+}
\ No newline at end of file
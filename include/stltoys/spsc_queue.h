@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include "detail/config.h"
+#include "detail/concepts.h"
+#include "detail/util.h"
+
+namespace ccat {
+	// A bounded queue for exactly one producer thread (`push`, `emplace`, `try_push_n`) and one consumer thread
+	// (`front`, `pop`, `try_pop_n`). Indices grow monotonically and are masked into a power-of-two ring; each side
+	// keeps a cached copy of the other side's index so that it only touches the shared line when the cache runs out.
+	template<typename T, typename Alloc = std::allocator<T>> requires std::same_as<T, std::remove_cvref_t<T>> && std::same_as<T, typename Alloc::value_type> && concepts::erasable<T, Alloc>
+	class spsc_queue {
+	public:
+		using value_type = T;
+		using allocator_type = Alloc;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = typename std::allocator_traits<allocator_type>::pointer;
+	public:
+		explicit spsc_queue(size_type capacity, const allocator_type& alloc = allocator_type()) : alloc_(alloc) { // `capacity` is rounded up to a power of two
+			if (capacity == 0 || capacity > (size_type{1} << (std::numeric_limits<size_type>::digits - 1))) {
+				throw std::length_error{"in `ccat::spsc_queue::spsc_queue`: the parameter `capacity` is out of range"};
+			}
+			capacity_ = std::bit_ceil(capacity);
+			mask_ = capacity_ - 1;
+			slots_ = std::allocator_traits<allocator_type>::allocate(alloc_, capacity_);
+		}
+
+		spsc_queue(const spsc_queue&) = delete;
+
+		~spsc_queue() {
+			auto head = head_.load(std::memory_order_relaxed);
+			auto tail = tail_.load(std::memory_order_relaxed);
+			for (; head != tail; ++head) {
+				std::allocator_traits<allocator_type>::destroy(alloc_, std::to_address(slots_ + (head & mask_)));
+			}
+			std::allocator_traits<allocator_type>::deallocate(alloc_, slots_, capacity_);
+		}
+	public:
+		auto operator= (const spsc_queue&) ->spsc_queue& = delete;
+
+		template<typename... Args> requires concepts::emplace_constructible_from<value_type, spsc_queue, Args...>
+		NODISCARD auto try_emplace(Args&&... args) ->bool { // producer only
+			auto tail = tail_.load(std::memory_order_relaxed);
+			if (tail - head_cache_ == capacity_) {
+				head_cache_ = head_.load(std::memory_order_acquire);
+				if (tail - head_cache_ == capacity_) return false;
+			}
+			std::allocator_traits<allocator_type>::construct(alloc_, std::to_address(slots_ + (tail & mask_)), std::forward<Args>(args)...);
+			tail_.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		NODISCARD auto try_push(const value_type& value) ->bool requires concepts::copy_insertable_into<value_type, spsc_queue> { // producer only
+			return this->try_emplace(value);
+		}
+
+		NODISCARD auto try_push(value_type&& value) ->bool requires concepts::move_insertable_into<value_type, spsc_queue> { // producer only
+			return this->try_emplace(std::move(value));
+		}
+
+		template<typename... Args> requires concepts::emplace_constructible_from<value_type, spsc_queue, Args...>
+		auto emplace(Args&&... args) ->void { // producer only, spins while the queue is full
+			while (!this->try_emplace(std::forward<Args>(args)...)) std::this_thread::yield();
+		}
+
+		auto push(const value_type& value) ->void requires concepts::copy_insertable_into<value_type, spsc_queue> { // producer only
+			this->emplace(value);
+		}
+
+		auto push(value_type&& value) ->void requires concepts::move_insertable_into<value_type, spsc_queue> { // producer only
+			this->emplace(std::move(value));
+		}
+
+		template<std::input_iterator InputIt> requires concepts::emplace_constructible_from<value_type, spsc_queue, std::iter_reference_t<InputIt>>
+		auto try_push_n(InputIt first, size_type count) ->size_type { // producer only, pushes as many as fit and publishes them at once
+			auto tail = tail_.load(std::memory_order_relaxed);
+			if (capacity_ - (tail - head_cache_) < count) head_cache_ = head_.load(std::memory_order_acquire);
+			count = std::min(count, capacity_ - (tail - head_cache_));
+			size_type i = 0;
+			try {
+				for (; i < count; ++i, ++first) {
+					std::allocator_traits<allocator_type>::construct(alloc_, std::to_address(slots_ + ((tail + i) & mask_)), *first);
+				}
+			}
+			catch (...) {
+				tail_.store(tail + i, std::memory_order_release); // keep what has been constructed
+				throw;
+			}
+			tail_.store(tail + count, std::memory_order_release);
+			return count;
+		}
+
+		NODISCARD auto front() noexcept ->reference { // consumer only, the queue must not be empty
+			return slots_[head_.load(std::memory_order_relaxed) & mask_];
+		}
+
+		auto pop() noexcept ->void { // consumer only, the queue must not be empty
+			auto head = head_.load(std::memory_order_relaxed);
+			std::allocator_traits<allocator_type>::destroy(alloc_, std::to_address(slots_ + (head & mask_)));
+			head_.store(head + 1, std::memory_order_release);
+		}
+
+		NODISCARD auto try_pop(value_type& out) ->bool requires std::is_move_assignable_v<value_type> { // consumer only
+			if (this->available_() == 0) return false;
+			out = std::move(front());
+			pop();
+			return true;
+		}
+
+		template<typename OutputIt> requires std::output_iterator<OutputIt, value_type&&>
+		auto try_pop_n(OutputIt d_first, size_type count) ->size_type { // consumer only, moves out as many as are ready and releases their slots at once
+			auto head = head_.load(std::memory_order_relaxed);
+			count = std::min(count, this->available_(count));
+			size_type i = 0;
+			try {
+				for (; i < count; ++i, ++d_first) {
+					auto slot = slots_ + ((head + i) & mask_);
+					*d_first = std::move(*slot);
+					std::allocator_traits<allocator_type>::destroy(alloc_, std::to_address(slot));
+				}
+			}
+			catch (...) {
+				head_.store(head + i, std::memory_order_release); // the element which failed to move stays at the front
+				throw;
+			}
+			head_.store(head + count, std::memory_order_release);
+			return count;
+		}
+
+		NODISCARD auto empty() const noexcept ->bool { // exact only on the consumer side
+			return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+		}
+
+		NODISCARD auto size() const noexcept ->size_type { // a snapshot, may be stale by the time it returns
+			auto head = head_.load(std::memory_order_acquire);
+			return tail_.load(std::memory_order_acquire) - head;
+		}
+
+		NODISCARD auto capacity() const noexcept ->size_type {
+			return capacity_;
+		}
+
+		NODISCARD auto get_allocator() const noexcept ->allocator_type {
+			return alloc_;
+		}
+	private:
+		auto available_(size_type wanted = 1) noexcept ->size_type { // consumer side: the number of elements ready to pop
+			auto head = head_.load(std::memory_order_relaxed);
+			if (static_cast<std::ptrdiff_t>(tail_cache_ - head) < static_cast<std::ptrdiff_t>(wanted)) { // `pop` may have run past the cached tail
+				tail_cache_ = tail_.load(std::memory_order_acquire);
+			}
+			return tail_cache_ - head;
+		}
+	private:
+		alignas(detail::cache_line_size) std::atomic<size_type> tail_{0}; // written by the producer
+		size_type head_cache_ = 0;
+		alignas(detail::cache_line_size) std::atomic<size_type> head_{0}; // written by the consumer
+		size_type tail_cache_ = 0;
+		alignas(detail::cache_line_size) pointer slots_{};
+		size_type capacity_{};
+		size_type mask_{};
+		allocator_type alloc_;
+	};
+}
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include "deque.h"
 
 namespace ccat {
-	template<typename T, typename Container>
+	template<typename T, typename Container = deque<T>>
 	class stack {
 	public:
 		using container_type = Container;
@@ -45,11 +45,11 @@ namespace ccat {
 		stack(from_range_t, Range&& rng, const Alloc& alloc) : container_(from_range, std::forward<Range>(rng), alloc) {}
 
 		NODISCARD auto top() noexcept(noexcept(std::declval<container_type&>().back())) ->reference {
-			container_.back();
+			return container_.back();
 		}
 
 		NODISCARD auto top() const noexcept(noexcept(std::declval<const container_type&>().back())) ->const_reference {
-			container_.back();
+			return container_.back();
 		}
 
 		auto push(const value_type& value) ->void {
@@ -116,25 +116,25 @@ namespace ccat {
 			return lhs.container_ <= rhs.container_;
 		}
 
-		friend auto operator<=> (const stack& lhs, const stack& rhs) requires std::three_way_comparable<container_type> ->std::compare_three_way_result_t<container_type> {
+		friend auto operator<=> (const stack& lhs, const stack& rhs) ->std::compare_three_way_result_t<container_type> requires std::three_way_comparable<container_type> {
 			return lhs.container_ <=> rhs.container_;
 		}
 
-		template<typename Container>
-		stack(Container) -> stack<typename Container::value_type, Container>;
+	private:
+		container_type container_;
+	};
 
-		template<typename Container, typename Alloc>
-		stack(Container, Alloc) -> stack<typename Container::value_type, Container>;
+	template<typename Container>
+	stack(Container) -> stack<typename Container::value_type, Container>;
 
-		template<std::input_iterator InputIt>
-		stack(InputIt, InputIt) -> stack<typename std::iterator_traits<InputIt>::value_type>;
+	template<typename Container, typename Alloc>
+	stack(Container, Alloc) -> stack<typename Container::value_type, Container>;
 
-		template<std::ranges::input_range R>
-		stack(from_range_t, R&&) -> stack<std::ranges::range_value_t<R>>;
+	template<std::input_iterator InputIt>
+	stack(InputIt, InputIt) -> stack<typename std::iterator_traits<InputIt>::value_type>;
 
-	private:
-		container_type container_;
-	};
+	template<std::ranges::input_range R>
+	stack(from_range_t, R&&) -> stack<std::ranges::range_value_t<R>>;
 }
 
 template<typename T, typename Container, typename Alloc>
@@ -0,0 +1,198 @@
+#pragma once
+#include <concepts>
+#include <memory>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "detail/concepts.h"
+#include "basic_string_view.h"
+
+// Concatenation that measures every piece first and writes into one buffer. A piece is a string, a string view,
+// a C string or a single character. `str_cat` builds a new string; `str_append` extends an existing one, and
+// `operator+` on strings returns a lazy `detail::string_concat` that does the same once it becomes a string.
+
+namespace ccat::detail {
+	template<typename T>
+	struct piece_char_type_ {};
+	
+	template<typename CharT> requires concepts::character<CharT>
+	struct piece_char_type_<CharT> {
+		using type = CharT;
+	};
+	
+	template<typename CharT> requires concepts::character<CharT>
+	struct piece_char_type_<CharT*> {
+		using type = CharT;
+	};
+	
+	template<typename CharT> requires concepts::character<CharT>
+	struct piece_char_type_<const CharT*> {
+		using type = CharT;
+	};
+	
+	template<typename CharT, std::size_t N> requires concepts::character<CharT>
+	struct piece_char_type_<CharT[N]> {
+		using type = CharT;
+	};
+	
+	template<typename T> requires requires { typename T::value_type; typename T::traits_type; }
+	struct piece_char_type_<T> {
+		using type = typename T::value_type;
+	};
+	
+	template<typename T>
+	using piece_char_t = typename piece_char_type_<std::remove_cvref_t<T>>::type;
+	
+	template<typename T, typename CharT, typename Traits>
+	concept string_piece = std::same_as<std::remove_cvref_t<T>, CharT> || std::convertible_to<const T&, basic_string_view<CharT, Traits>>;
+	
+	template<typename T>
+	struct is_basic_string_ : std::false_type {};
+	
+	template<typename CharT, typename Traits, typename Alloc, typename GrowthPolicy, typename Layout>
+	struct is_basic_string_<basic_string<CharT, Traits, Alloc, GrowthPolicy, Layout>> : std::true_type {};
+	
+	template<typename First, typename... Rest>
+	struct str_cat_result_ {
+		using type = basic_string<piece_char_t<First>>;
+	};
+	
+	template<typename First, typename... Rest> requires is_basic_string_<std::remove_cvref_t<First>>::value
+	struct str_cat_result_<First, Rest...> { // keep the traits, allocator, growth policy and layout of a leading string
+		using type = std::remove_cvref_t<First>;
+	};
+	
+	template<typename String, typename T>
+	CONSTEXPR auto as_piece(const T& piece) noexcept ->basic_string_view<typename String::value_type, typename String::traits_type> {
+		if constexpr (std::same_as<T, typename String::value_type>) return {std::addressof(piece), 1};
+		else return static_cast<basic_string_view<typename String::value_type, typename String::traits_type>>(piece);
+	}
+	
+	template<typename String, typename... Views>
+	CONSTEXPR auto append_pieces(String& dst, const Views&... pieces) ->void {
+		using traits_type = typename String::traits_type;
+		auto old_size = dst.size();
+		auto new_size = old_size + (pieces.size() + ... + std::size_t{0});
+		auto write = [&](typename String::value_type* out) {
+			((pieces.empty() ? void() : void(traits_type::copy(out, pieces.data(), pieces.size())), out += pieces.size()), ...);
+		};
+		if (new_size <= dst.capacity()) { // pieces viewing `dst` stay valid, nothing moves
+			dst.resize_and_overwrite(new_size, [&](typename String::value_type* buf, std::size_t n) {
+				write(buf + old_size);
+				return n;
+			});
+		}
+		else { // fill a fresh buffer while the old one, which pieces may view, is still alive
+			String tmp(dst.get_allocator());
+			tmp.reserve(String::growth_policy_type::grow(old_size, new_size, dst.get_allocator())); // from the size, like `basic_string::grow_`
+			tmp.resize_and_overwrite(new_size, [&](typename String::value_type* buf, std::size_t n) {
+				traits_type::copy(buf, dst.data(), old_size);
+				write(buf + old_size);
+				return n;
+			});
+			dst = std::move(tmp);
+		}
+	}
+	
+	template<typename String, typename... Parts>
+	class string_concat { // the pending result of `a + b + ...`; converts to `String` with one allocation, and only as an rvalue
+	public:
+		using string_type = String;
+		using value_type = typename String::value_type;
+		using traits_type = typename String::traits_type;
+		using allocator_type = typename String::allocator_type;
+		using size_type = typename String::size_type;
+		using view_type = basic_string_view<value_type, traits_type>;
+	private:
+		template<typename T> // a string rvalue is kept by value, so `f() + "x"` owns what `f()` returned
+		using part_t = std::conditional_t<
+			std::same_as<std::remove_cvref_t<T>, value_type>, value_type,
+			std::conditional_t<std::same_as<T, String>, String, view_type>
+		>;
+		
+		template<typename S, typename... Ps>
+		friend class string_concat;
+	public:
+		CONSTEXPR string_concat(const allocator_type& alloc, std::tuple<Parts...> parts) : alloc_(alloc), parts_(std::move(parts)) {}
+		
+		// a named node would read its operands whenever it is finally used, so it can be neither copied nor converted as an lvalue
+		string_concat(const string_concat&) = delete;
+		
+		auto operator= (const string_concat&) ->string_concat& = delete;
+		
+		NODISCARD CONSTEXPR auto size() const noexcept ->size_type {
+			return std::apply([](const auto&... parts) { return (as_piece<String>(parts).size() + ... + size_type{0}); }, parts_);
+		}
+		
+		auto str() const& ->String = delete;
+		
+		NODISCARD CONSTEXPR auto str() && ->String {
+			if constexpr (sizeof...(Parts) > 0 && std::same_as<std::tuple_element_t<0, std::tuple<Parts..., void>>, String>) { // reuse the buffer of a leading rvalue
+				String res = std::move(std::get<0>(parts_));
+				[&]<std::size_t... I>(std::index_sequence<I...>) {
+					append_pieces(res, as_piece<String>(std::get<I + 1>(parts_))...);
+				}(std::make_index_sequence<sizeof...(Parts) - 1>{});
+				return res;
+			}
+			else {
+				String res(alloc_);
+				res.reserve(size());
+				std::apply([&](const auto&... parts) { append_pieces(res, as_piece<String>(parts)...); }, parts_);
+				return res;
+			}
+		}
+		
+		operator String() const& = delete;
+		
+		CONSTEXPR operator String() && {
+			return std::move(*this).str();
+		}
+		
+		template<typename T> requires string_piece<T, value_type, traits_type>
+		friend CONSTEXPR auto operator+ (string_concat&& lhs, T&& rhs) ->string_concat<String, Parts..., part_t<T>> {
+			return {lhs.alloc_, std::tuple_cat(std::move(lhs.parts_), std::tuple<part_t<T>>(std::forward<T>(rhs)))};
+		}
+		
+		template<typename T> requires string_piece<T, value_type, traits_type>
+		friend CONSTEXPR auto operator+ (T&& lhs, string_concat&& rhs) ->string_concat<String, part_t<T>, Parts...> {
+			return {rhs.alloc_, std::tuple_cat(std::tuple<part_t<T>>(std::forward<T>(lhs)), std::move(rhs.parts_))};
+		}
+		
+		template<typename... Others>
+		friend CONSTEXPR auto operator+ (string_concat&& lhs, string_concat<String, Others...>&& rhs) ->string_concat<String, Parts..., Others...> {
+			return {lhs.alloc_, std::tuple_cat(std::move(lhs.parts_), std::move(rhs.parts_))};
+		}
+		
+		friend auto operator<< (std::basic_ostream<value_type, std::char_traits<value_type>>& os, string_concat&& concat) ->std::basic_ostream<value_type, std::char_traits<value_type>>& {
+			std::apply([&](const auto&... parts) { (void) (os << ... << as_piece<String>(parts)); }, concat.parts_);
+			return os;
+		}
+	private:
+		allocator_type alloc_;
+		std::tuple<Parts...> parts_;
+	};
+}
+
+namespace ccat {
+	template<typename String, typename... Args> requires detail::is_basic_string_<String>::value && (detail::string_piece<Args, typename String::value_type, typename String::traits_type> && ...)
+	CONSTEXPR auto str_append(String& dst, const Args&... args) ->String& {
+		detail::append_pieces(dst, detail::as_piece<String>(args)...);
+		return dst;
+	}
+	
+	template<typename... Args> requires (sizeof...(Args) > 0)
+	NODISCARD CONSTEXPR auto str_cat(const Args&... args) ->typename detail::str_cat_result_<Args...>::type {
+		using string_type = typename detail::str_cat_result_<Args...>::type;
+		static_assert((detail::string_piece<Args, typename string_type::value_type, typename string_type::traits_type> && ...), "every argument of `ccat::str_cat` must be a piece of the same character type");
+		auto res = [&](const auto& first, const auto&...) {
+			if constexpr (detail::is_basic_string_<std::remove_cvref_t<decltype(first)>>::value) return string_type(first.get_allocator());
+			else return string_type();
+		}(args...);
+		res.reserve((detail::as_piece<string_type>(args).size() + ...));
+		detail::append_pieces(res, detail::as_piece<string_type>(args)...);
+		return res;
+	}
+}
+
+#include "basic_string.h"
\ No newline at end of file
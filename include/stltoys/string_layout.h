@@ -0,0 +1,9 @@
+#pragma once
+
+// A string layout picks how `basic_string` stores its characters. It is the last template parameter of `basic_string`.
+
+namespace ccat::string_layout {
+	struct pointers {}; // begin, end and capacity pointers next to a separate SSO buffer; sized by `CCAT_sso_size_of_basic_string_*`
+
+	struct compact {}; // the SSO buffer overlaps the heap pointer, size and capacity: 24 bytes on 64-bit targets, 22 inline `char`s
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <stltoys/detail/util.h>
+
+// allocators shared by the container tests
+
+namespace {
+	template<typename T>
+	struct counting_allocator {
+		using value_type = T;
+
+		counting_allocator() = default;
+
+		template<typename U>
+		counting_allocator(const counting_allocator<U>&) noexcept {}
+
+		auto allocate(std::size_t n) ->T* {
+			++allocations;
+			return std::allocator<T>{}.allocate(n);
+		}
+
+		auto deallocate(T* p, std::size_t n) noexcept ->void {
+			std::allocator<T>{}.deallocate(p, n);
+		}
+
+		friend auto operator== (const counting_allocator&, const counting_allocator&) noexcept ->bool = default;
+
+		static inline std::size_t allocations = 0;
+	};
+
+	template<typename T>
+	struct generous_allocator : std::allocator<T> { // hands out 7 more elements than asked for
+		using value_type = T;
+
+		generous_allocator() = default;
+
+		template<typename U>
+		generous_allocator(const generous_allocator<U>&) noexcept {}
+
+		template<typename U>
+		struct rebind {
+			using other = generous_allocator<U>;
+		};
+
+		auto allocate_at_least(std::size_t n) ->ccat::allocation_result<T*> {
+			return {std::allocator<T>::allocate(n + 7), n + 7};
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <stltoys/deque.h>
+#include <stltoys/stack.h>
+#include <stltoys/queue.h>
+#include <gtest/gtest.h>
+#include "test_allocators.h"
+
+static_assert(std::ranges::random_access_range<ccat::deque<int>>);
+static_assert(ccat::deque<char>::block_size * sizeof(char) % 64 == 0);
+static_assert(ccat::deque<std::string>::block_size * sizeof(std::string) % 64 == 0);
+
+class test_deque : public testing::Test {};
+
+TEST_F(test_deque, push_and_pop_at_both_ends) {
+	ccat::deque<int> deq;
+	for (int i = 0; i < 1000; ++i) {
+		deq.push_back(i);
+		deq.push_front(-i - 1);
+	}
+	EXPECT_EQ(deq.size(), 2000u);
+	EXPECT_EQ(deq.front(), -1000);
+	EXPECT_EQ(deq.back(), 999);
+	for (int i = 0; i < 2000; ++i) EXPECT_EQ(deq[i], i - 1000);
+	EXPECT_TRUE(std::ranges::equal(deq | std::views::reverse, std::views::iota(-1000, 1000) | std::views::reverse));
+	EXPECT_EQ(deq.end() - deq.begin(), 2000);
+	EXPECT_EQ(*(deq.end() - 1500), -500);
+	EXPECT_THROW((void) deq.at(2000), std::out_of_range);
+	for (int i = 0; i < 999; ++i) {
+		deq.pop_front();
+		deq.pop_back();
+	}
+	EXPECT_EQ(deq, (ccat::deque{-1, 0}));
+}
+
+TEST_F(test_deque, elements_stay_in_place) {
+	ccat::deque<std::string> deq{"first"};
+	const std::string* first = &deq.front();
+	for (int i = 0; i < 10000; ++i) {
+		deq.emplace_back(std::to_string(i));
+		deq.emplace_front(deq.back()); // the argument is an element
+	}
+	EXPECT_EQ(first, &deq[10000]);
+	EXPECT_EQ(*first, "first");
+	EXPECT_EQ(deq.front(), "9999");
+}
+
+TEST_F(test_deque, fifo_reuses_blocks) {
+	using alloc_type = counting_allocator<int>;
+	ccat::deque<int, alloc_type> deq;
+	for (int i = 0; i < 100; ++i) deq.push_back(i);
+	for (int i = 100; i < 500000; ++i) { // warm up: every slot of the map gets a block
+		deq.push_back(i);
+		deq.pop_front();
+	}
+	alloc_type::allocations = 0;
+	for (int i = 500000; i < 1000000; ++i) {
+		deq.push_back(i);
+		deq.pop_front();
+	}
+	EXPECT_EQ(alloc_type::allocations, 0u);
+	EXPECT_EQ(deq.size(), 100u);
+	EXPECT_EQ(deq.front(), 999900);
+	deq.shrink_to_fit();
+	EXPECT_EQ(deq.back(), 999999);
+}
+
+TEST_F(test_deque, insert_and_erase) {
+	ccat::deque<std::string> deq{"a", "d"};
+	deq.insert(deq.begin() + 1, {"b", "c"});
+	EXPECT_EQ(deq, (ccat::deque<std::string>{"a", "b", "c", "d"}));
+	deq.insert(deq.begin(), 2, "z");
+	deq.insert(deq.end() - 1, 2, "y");
+	EXPECT_EQ(deq, (ccat::deque<std::string>{"z", "z", "a", "b", "c", "y", "y", "d"}));
+	deq.emplace(deq.begin() + 2, 3, 'x');
+	deq.emplace(deq.end() - 2, 3, 'w');
+	EXPECT_EQ(deq, (ccat::deque<std::string>{"z", "z", "xxx", "a", "b", "c", "y", "www", "y", "d"}));
+	deq.erase(deq.begin(), deq.begin() + 2);
+	deq.erase(deq.end() - 3, deq.end() - 1);
+	deq.erase(deq.begin() + 1);
+	EXPECT_EQ(deq, (ccat::deque<std::string>{"xxx", "b", "c", "y", "d"}));
+	EXPECT_EQ(ccat::erase(deq, "y"), 1u);
+	EXPECT_EQ(ccat::erase_if(deq, [](const std::string& s) { return s.size() > 1; }), 1u);
+	EXPECT_EQ(deq, (ccat::deque<std::string>{"b", "c", "d"}));
+
+	ccat::deque<int> nums(ccat::from_range, std::views::iota(0, 1000));
+	nums.insert_range(nums.begin() + 10, std::views::iota(0, 500));
+	nums.prepend_range(std::views::iota(-5, 0));
+	std::istringstream in{"7 8 9"};
+	nums.insert(nums.end() - 10, std::istream_iterator<int>{in}, std::istream_iterator<int>{});
+	EXPECT_EQ(nums.size(), 1508u);
+	EXPECT_EQ(nums[0], -5);
+	EXPECT_EQ(nums[15], 0);
+	EXPECT_EQ(nums[514], 499);
+	EXPECT_EQ(nums[515], 10);
+	EXPECT_EQ(nums[1495], 7);
+	EXPECT_EQ(nums.back(), 999);
+}
+
+TEST_F(test_deque, copy_move_assign_and_resize) {
+	ccat::deque<std::string> deq1(600, "x");
+	ccat::deque<std::string> deq2{deq1};
+	EXPECT_EQ(deq1, deq2);
+	ccat::deque<std::string> deq3{std::move(deq2)};
+	EXPECT_TRUE(deq2.empty());
+	EXPECT_EQ(deq3.size(), 600u);
+	deq2 = {"a", "b"};
+	deq3 = deq2;
+	EXPECT_EQ(deq3, (ccat::deque<std::string>{"a", "b"}));
+	deq1.swap(deq3);
+	EXPECT_EQ(deq3.size(), 600u);
+	deq3.resize(3);
+	deq3.resize(5, "y");
+	EXPECT_EQ(deq3, (ccat::deque<std::string>{"x", "x", "x", "y", "y"}));
+	deq3.assign(2, "q");
+	EXPECT_EQ(deq3, (ccat::deque<std::string>{"q", "q"}));
+	deq1.clear();
+	EXPECT_TRUE(deq1.empty());
+	EXPECT_LT(deq1, deq3);
+}
+
+TEST_F(test_deque, adapters) {
+	ccat::stack<int> stk;
+	ccat::queue<int> que;
+	for (int i = 0; i < 10; ++i) {
+		stk.push(i);
+		que.emplace(i);
+	}
+	EXPECT_EQ(stk.top(), 9);
+	EXPECT_EQ(que.front(), 0);
+	EXPECT_EQ(que.back(), 9);
+	stk.pop();
+	que.pop();
+	EXPECT_EQ(stk.top(), 8);
+	EXPECT_EQ(que.front(), 1);
+	EXPECT_EQ(stk.size(), 9u);
+	EXPECT_EQ(que.size(), 9u);
+
+	ccat::queue que2{ccat::deque{1, 2, 3}};
+	que2.push_range(std::views::iota(4, 6));
+	EXPECT_EQ(que2.back(), 5);
+	EXPECT_EQ(que2, (ccat::queue{ccat::deque{1, 2, 3, 4, 5}}));
+}
+
+auto main(int argc, char* argv[]) ->int {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stltoys/function.h>
+#include <gtest/gtest.h>
+
+class test_function : public testing::Test {};
+
+namespace {
+	template<typename T, typename Fn>
+	auto stored_inline(const Fn& fn) ->bool {
+		auto p = reinterpret_cast<const std::byte*>(fn.template target<T>());
+		auto self = reinterpret_cast<const std::byte*>(std::addressof(fn));
+		return p >= self && p < self + sizeof(fn);
+	}
+
+	auto twice(int x) ->int {
+		return 2 * x;
+	}
+}
+
+TEST_F(test_function, small_buffer) {
+	static_assert(sizeof(ccat::function<int(int)>) == 3 * sizeof(void*)); // an operations table pointer and two words of storage
+	auto counter = std::make_shared<int>(0);
+	auto small = [counter](int x) { return x + ++*counter; };
+	auto big = [counter, pad = std::array<char, 64>{}](int x) { return x + ++*counter + pad[0]; };
+	ccat::function<int(int)> a = small;
+	ccat::function<int(int)> b = big;
+	ccat::function<int(int)> c = &twice;
+	EXPECT_TRUE(stored_inline<decltype(small)>(a));
+	EXPECT_FALSE(stored_inline<decltype(big)>(b));
+	EXPECT_TRUE(stored_inline<int(*)(int)>(c));
+	EXPECT_EQ(a(1), 2);
+	EXPECT_EQ(b(1), 3);
+	EXPECT_EQ(c(4), 8);
+	EXPECT_EQ(counter.use_count(), 5);
+
+	auto a2 = a;
+	auto b2 = b;
+	EXPECT_EQ(counter.use_count(), 7);
+	auto a3 = std::move(a2);
+	auto b3 = std::move(b2);
+	EXPECT_FALSE(a2);
+	EXPECT_FALSE(b2);
+	EXPECT_TRUE(a2 == nullptr);
+	EXPECT_EQ(a3(0), 3);
+	EXPECT_EQ(b3(0), 4);
+	EXPECT_EQ(counter.use_count(), 7);
+
+	a3.swap(b3); // inline and heap targets trade places
+	EXPECT_NE(a3.target<decltype(big)>(), nullptr);
+	EXPECT_NE(b3.target<decltype(small)>(), nullptr);
+	EXPECT_EQ(a3.target<decltype(small)>(), nullptr);
+	EXPECT_EQ(a3(0), 5);
+	a3 = nullptr;
+	b3 = std::move(c);
+	EXPECT_EQ(b3(5), 10);
+	EXPECT_EQ(counter.use_count(), 5);
+	a = b = nullptr;
+	EXPECT_EQ(counter.use_count(), 3);
+
+	int calls = 0;
+	ccat::function<void()> discards = [&calls] { return ++calls; }; // a void signature drops the result
+	discards();
+	EXPECT_EQ(calls, 1);
+}
+
+TEST_F(test_function, assignment) {
+	ccat::function<std::string(std::string)> fn;
+	EXPECT_THROW(fn("x"), std::bad_function_call);
+	EXPECT_EQ(fn.target_type(), typeid(void));
+	fn = [](std::string s) { return s + s; };
+	EXPECT_EQ(fn("ab"), "abab");
+	std::string suffix(40, '!');
+	auto append = [suffix](std::string s) { return s + suffix; };
+	fn = append;
+	EXPECT_EQ(fn("a"), "a" + suffix);
+	EXPECT_EQ(fn.target_type(), typeid(append));
+	auto copy = fn;
+	fn = copy;
+	fn = std::move(fn);
+	EXPECT_EQ(fn("b"), "b" + suffix);
+	fn = std::ref(append);
+	EXPECT_NE(fn.target<std::reference_wrapper<decltype(append)>>(), nullptr);
+	EXPECT_EQ(copy("c"), "c" + suffix);
+	ccat::function deduced = [](int x) { return x + 1; };
+	static_assert(std::is_same_v<decltype(deduced), ccat::function<int(int)>>);
+	EXPECT_EQ(deduced(1), 2);
+}
+
+TEST_F(test_function, inplace_function) {
+	using callback = ccat::inplace_function<int(int), 48>;
+	static_assert(sizeof(callback) == 48 + alignof(std::max_align_t));
+	auto counter = std::make_shared<int>(0);
+	auto wide = [counter, pad = std::array<char, 24>{}](int x) { return x + ++*counter + pad[0]; };
+	callback a = wide;
+	EXPECT_EQ(a(1), 2);
+	EXPECT_TRUE(stored_inline<decltype(wide)>(a));
+	auto b = a;
+	EXPECT_EQ(counter.use_count(), 4);
+	auto c = std::move(b);
+	EXPECT_FALSE(b);
+	EXPECT_EQ(c(1), 3);
+	EXPECT_EQ(counter.use_count(), 4);
+	b = &twice;
+	b.swap(c);
+	EXPECT_EQ(b(1), 4);
+	EXPECT_EQ(c(3), 6);
+	EXPECT_EQ(b.target_type(), typeid(wide));
+	EXPECT_NE(c.target<int(*)(int)>(), nullptr);
+	a = nullptr;
+	b = nullptr;
+	EXPECT_EQ(counter.use_count(), 2); // `wide` itself is left
+	EXPECT_THROW(a(0), std::bad_function_call);
+
+	ccat::inplace_function deduced = [](std::string s) { return s.size(); };
+	static_assert(std::is_same_v<decltype(deduced), ccat::inplace_function<std::size_t(std::string)>>);
+	EXPECT_EQ(deduced("four"), 4u);
+	ccat::inplace_function from_pointer = &twice;
+	static_assert(std::is_same_v<decltype(from_pointer), ccat::inplace_function<int(int)>>);
+
+	int calls = 0;
+	ccat::inplace_function<void()> discards = [&calls] { return ++calls; }; // a void signature drops the result
+	discards();
+	EXPECT_EQ(calls, 1);
+}
+
+namespace {
+	struct accumulator {
+		accumulator(int start, std::string name) : total(start), name(std::move(name)) {}
+
+		auto operator() (int x) && ->std::string {
+			return name + std::to_string(total + x);
+		}
+
+		int total;
+		std::string name;
+	};
+}
+
+TEST_F(test_function, move_only) {
+	auto counter = std::make_shared<int>(0);
+	auto owned = std::make_unique<int>(5);
+	ccat::move_only_function<int(int)> a = [p = std::move(owned)](int x) { return *p + x; };
+	ccat::move_only_function<int(int) const noexcept> b = [counter, pad = std::array<char, 64>{}](int x) noexcept { return x + *counter + pad[0]; };
+	EXPECT_TRUE(a);
+	EXPECT_EQ(a(1), 6);
+	EXPECT_EQ(b(2), 2);
+	EXPECT_EQ(counter.use_count(), 2);
+
+	auto c = std::move(b);
+	EXPECT_FALSE(b);
+	EXPECT_TRUE(b == nullptr);
+	EXPECT_EQ(c(3), 3);
+	b = std::move(c); // hands the heap target back
+	c = [counter](int x) noexcept { return x - *counter; };
+	EXPECT_EQ(counter.use_count(), 3);
+	b.swap(c);
+	EXPECT_EQ(b(4), 4);
+	EXPECT_EQ(c(4), 4);
+	b = nullptr;
+	c = nullptr;
+	EXPECT_EQ(counter.use_count(), 1);
+
+	ccat::move_only_function<std::string(int) &&> d(std::in_place_type<accumulator>, 40, "sum ");
+	EXPECT_EQ(std::move(d)(2), "sum 42");
+	ccat::move_only_function<int(int) &> e = &twice;
+	EXPECT_EQ(e(21), 42);
+	ccat::move_only_function<int(int)> null_pointer = static_cast<int(*)(int)>(nullptr);
+	EXPECT_FALSE(null_pointer);
+	a = ccat::move_only_function<int(int) const>(&twice); // wraps the other specialization
+	EXPECT_EQ(a(3), 6);
+}
+
+namespace {
+	auto sum_each(const std::vector<int>& v, ccat::function_ref<void(int)> visit) ->void {
+		for (auto x : v) visit(x);
+	}
+
+	template<typename Ref, typename F>
+	concept binds = requires (F&& f) { Ref(std::forward<F>(f)); };
+}
+
+TEST_F(test_function, function_ref) {
+	static_assert(std::is_trivially_copyable_v<ccat::function_ref<int(int)>>);
+	static_assert(sizeof(ccat::function_ref<int(int) const noexcept>) == 2 * sizeof(void*));
+	int total = 0;
+	auto add = [&total](int x) { total += x; };
+	sum_each({1, 2, 3}, add);
+	sum_each({4}, [&total](int x) { total += 10 * x; });
+	EXPECT_EQ(total, 46);
+
+	ccat::function_ref<int(int)> twice_ref = twice;
+	ccat::function_ref deduced = &twice;
+	static_assert(std::is_same_v<decltype(deduced), ccat::function_ref<int(int)>>);
+	EXPECT_EQ(twice_ref(3), 6);
+	EXPECT_EQ(deduced(4), 8);
+	auto copy = twice_ref;
+	int bias = 1;
+	auto biased = [&bias](int x) { return x + bias; };
+	twice_ref = ccat::function_ref<int(int)>(biased);
+	bias = 5;
+	EXPECT_EQ(twice_ref(1), 6);
+	EXPECT_EQ(copy(1), 2);
+
+	ccat::function<int(int)> owner = twice;
+	ccat::function_ref<int(int) const> to_owner = owner;
+	EXPECT_EQ(to_owner(5), 10);
+	auto mutating = [n = 0](int x) mutable { return n += x; };
+	ccat::function_ref<int(int)> to_mutating = mutating;
+	to_mutating(2);
+	EXPECT_EQ(to_mutating(3), 5);
+	static_assert(!binds<ccat::function_ref<int(int) const>, decltype(mutating)&>);
+	static_assert(!binds<ccat::function_ref<int(int) noexcept>, decltype(biased)&>);
+	static_assert(binds<ccat::function_ref<int(int) noexcept>, decltype([](int x) noexcept { return x; })>);
+	static_assert(!std::is_assignable_v<ccat::function_ref<int(int)>&, decltype(biased)>);
+}
+
+auto main(int argc, char* argv[]) ->int {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// iterators shared by the container tests
+
+namespace {
+	struct letter_input { // single pass: copies share one cursor, so re-reading from a copy yields later letters
+		using value_type = std::string;
+		using difference_type = std::ptrdiff_t;
+
+		auto operator* () const ->std::string {
+			return std::string(1, *next);
+		}
+		auto operator++ () ->letter_input& {
+			++*next;
+			return *this;
+		}
+		auto operator++ (int) ->void {
+			++*next;
+		}
+
+		char* next;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stltoys/mpmc_queue.h>
+#include <gtest/gtest.h>
+
+class test_mpmc_queue : public testing::Test {};
+
+TEST_F(test_mpmc_queue, single_thread) {
+	ccat::mpmc_queue<std::string> queue{3};
+	EXPECT_EQ(queue.capacity(), 4u);
+	EXPECT_TRUE(queue.empty());
+	EXPECT_TRUE(queue.try_push("a"));
+	EXPECT_TRUE(queue.try_emplace(2, 'b'));
+	queue.push("c");
+	queue.emplace("d");
+	EXPECT_FALSE(queue.try_push("e"));
+	EXPECT_EQ(queue.size(), 4u);
+	EXPECT_EQ(queue.pop(), "a");
+	std::string out;
+	EXPECT_TRUE(queue.try_pop(out));
+	EXPECT_EQ(out, "bb");
+	for (int i = 0; i < 10; ++i) { // several laps around the ring
+		queue.push(std::to_string(i));
+		EXPECT_TRUE(queue.try_pop(out));
+	}
+	EXPECT_EQ(queue.pop(), "8");
+	EXPECT_EQ(queue.size(), 1u);
+	EXPECT_THROW(ccat::mpmc_queue<int>{0}, std::length_error);
+}
+
+TEST_F(test_mpmc_queue, many_threads) {
+	constexpr int producers = 4;
+	constexpr int consumers = 4;
+	constexpr int per_producer = 100000;
+	ccat::mpmc_queue<int> queue{128};
+	std::vector<std::vector<int>> received(consumers);
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p) {
+		threads.emplace_back([&, p] {
+			for (int i = 0; i < per_producer; ++i) {
+				int value = p * per_producer + i;
+				if (i % 2 == 0) queue.push(value);
+				else while (!queue.try_push(value)) std::this_thread::yield();
+			}
+		});
+	}
+	for (int c = 0; c < consumers; ++c) {
+		threads.emplace_back([&, c] {
+			for (int i = 0; i < producers * per_producer / consumers; ++i) {
+				int value;
+				if (i % 2 == 0) value = queue.pop();
+				else while (!queue.try_pop(value)) std::this_thread::yield();
+				received[c].push_back(value);
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	std::vector<int> all;
+	for (auto& part : received) {
+		std::vector<int> last(producers, -1);
+		for (auto value : part) { // one producer's values reach one consumer in order
+			EXPECT_GT(value, last[value / per_producer]);
+			last[value / per_producer] = value;
+		}
+		all.insert(all.end(), part.begin(), part.end());
+	}
+	std::sort(all.begin(), all.end());
+	ASSERT_EQ(all.size(), static_cast<std::size_t>(producers * per_producer));
+	for (int i = 0; i < producers * per_producer; ++i) EXPECT_EQ(all[i], i);
+	EXPECT_TRUE(queue.empty());
+}
+
+auto main(int argc, char* argv[]) ->int {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <stltoys/pool_resource.h>
+#include <stltoys/vector.h>
+#include <stltoys/string.h>
+#include <stltoys/function.h>
+#include <gtest/gtest.h>
+
+class test_pool_resource : public testing::Test {};
+
+TEST_F(test_pool_resource, size_classes) {
+	ccat::pool_resource pool;
+	std::vector<std::pair<void*, std::size_t>> blocks;
+	for (std::size_t bytes : {1, 16, 17, 32, 100, 256, 1000, 1024, 1025, 5000}) {
+		auto p = pool.allocate(bytes);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignof(std::max_align_t), 0u);
+		std::memset(p, 0x5a, bytes);
+		blocks.emplace_back(p, bytes);
+	}
+	auto over_aligned = pool.allocate(64, 64);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(over_aligned) % 64, 0u);
+	pool.deallocate(over_aligned, 64, 64);
+	for (auto [p, bytes] : blocks) pool.deallocate(p, bytes);
+
+	auto p = pool.allocate(48);
+	pool.deallocate(p, 48);
+	EXPECT_EQ(pool.allocate(64), p); // the freed block is handed out again from the thread's cache
+}
+
+TEST_F(test_pool_resource, containers) {
+	ccat::pool_resource pool;
+	ccat::vector<int, ccat::pool_allocator<int>> vec(pool);
+	for (int i = 0; i < 1000; ++i) vec.push_back(i);
+	EXPECT_EQ(vec.back(), 999);
+	EXPECT_EQ(vec.get_allocator().resource(), &pool);
+
+	ccat::vector<int, ccat::pool_allocator<int>> defaulted{1, 2, 3};
+	EXPECT_EQ(defaulted.get_allocator().resource(), &ccat::pool_resource::default_resource());
+	defaulted = std::move(vec); // the allocator moves along
+	EXPECT_EQ(defaulted.get_allocator().resource(), &pool);
+	EXPECT_EQ(defaulted.size(), 1000u);
+
+	using pool_string = ccat::basic_string<char, ccat::char_traits<char>, ccat::pool_allocator<char>>;
+	pool_string str(100, 'x', pool);
+	str += str;
+	EXPECT_EQ(str.size(), 200u);
+	EXPECT_EQ(str.substr(150).get_allocator(), str.get_allocator());
+}
+
+TEST_F(test_pool_resource, function_targets) {
+	ccat::pool_resource pool;
+	auto counter = std::make_shared<int>(0);
+	auto lambda = [counter, pad = std::array<char, 40>{}](int x) {
+		return x + ++*counter + pad[0];
+	};
+	ccat::function<int(int)> fn(std::allocator_arg, ccat::pool_allocator<char>(pool), lambda);
+	EXPECT_EQ(fn(1), 2);
+	auto copy = fn;
+	EXPECT_EQ(copy(1), 3);
+	EXPECT_EQ(counter.use_count(), 4);
+	auto target = copy.target<decltype(lambda)>();
+	ASSERT_NE(target, nullptr);
+	fn = nullptr;
+	copy = nullptr;
+	EXPECT_EQ(counter.use_count(), 2);
+	EXPECT_EQ(pool.allocate(sizeof(lambda) + sizeof(void*)), static_cast<void*>(target)); // the copy's block went back to the pool
+}
+
+TEST_F(test_pool_resource, threads) {
+	ccat::pool_resource pool;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&pool, t] {
+			std::vector<std::pair<unsigned char*, std::size_t>> live;
+			for (std::size_t i = 0; i < 20000; ++i) {
+				auto bytes = 16 + (i * 37 + t) % 241;
+				auto p = static_cast<unsigned char*>(pool.allocate(bytes));
+				std::memset(p, t, bytes);
+				live.emplace_back(p, bytes);
+				if (live.size() > 64) {
+					auto victim = (i * 7) % live.size();
+					EXPECT_EQ(live[victim].first[live[victim].second - 1], t);
+					pool.deallocate(live[victim].first, live[victim].second);
+					live[victim] = live.back();
+					live.pop_back();
+				}
+			}
+			for (auto [p, bytes] : live) pool.deallocate(p, bytes);
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	auto survivor = std::make_unique<ccat::pool_resource>(); // blocks cached by a thread outlive the resource safely
+	std::thread{[&] {
+		auto p = survivor->allocate(32);
+		survivor->deallocate(p, 32);
+		survivor.reset();
+	}}.join();
+}
+
+TEST_F(test_pool_resource, many_resources_on_one_thread) { // a long-lived thread keeps getting a cache as resources come and go
+	constexpr int rounds = 10;
+	std::unique_ptr<ccat::pool_resource> current;
+	void* cached = nullptr;
+	std::atomic<int> step{0}; // odd while the worker has its turn
+	std::thread worker{[&] {
+		for (int i = 0; i < rounds; ++i) {
+			step.wait(2 * i);
+			cached = current->allocate(32);
+			current->deallocate(cached, 32);
+			step.store(2 * i + 2);
+			step.notify_one();
+		}
+		step.wait(2 * rounds); // exiting would flush the cache, so stay until the last round is checked
+	}};
+	for (int i = 0; i < rounds; ++i) {
+		current = std::make_unique<ccat::pool_resource>();
+		step.store(2 * i + 1);
+		step.notify_one();
+		step.wait(2 * i + 1);
+		auto p = current->allocate(32);
+		EXPECT_NE(p, cached) << "round " << i; // the worker's block sits in its cache; uncached it would be back in the pool
+		current->deallocate(p, 32);
+		current.reset(); // destroyed here, not on the worker
+	}
+	step.store(2 * rounds + 1);
+	step.notify_one();
+	worker.join();
+}
+
+auto main(int argc, char* argv[]) ->int {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <string>
+#include <stltoys/small_vector.h>
+#include <gtest/gtest.h>
+#include "test_allocators.h"
+#include "test_iterators.h"
+
+static_assert(std::ranges::contiguous_range<ccat::small_vector<int, 4>>);
+
+class test_small_vector : public testing::Test {};
+
+TEST_F(test_small_vector, stays_inline) {
+	using alloc_type = counting_allocator<int>;
+	alloc_type::allocations = 0;
+	ccat::small_vector<int, 8, alloc_type> vec;
+	for (int i = 0; i < 8; ++i) vec.push_back(i);
+	EXPECT_TRUE(vec.is_inline());
+	EXPECT_EQ(vec.capacity(), 8u);
+	EXPECT_EQ(alloc_type::allocations, 0u);
+	vec.push_back(8);
+	EXPECT_FALSE(vec.is_inline());
+	EXPECT_EQ(alloc_type::allocations, 1u);
+	for (int i = 0; i < 9; ++i) EXPECT_EQ(vec[i], i);
+	vec.erase(vec.begin() + 2, vec.end());
+	vec.shrink_to_fit();
+	EXPECT_TRUE(vec.is_inline());
+	EXPECT_EQ(vec, (ccat::small_vector<int, 8, alloc_type>{0, 1}));
+}
+
+TEST_F(test_small_vector, insert_and_erase) {
+	ccat::small_vector<std::string, 4> vec{"a", "d"};
+	vec.insert(vec.begin() + 1, {"b", "c"});
+	EXPECT_EQ(vec, (ccat::small_vector<std::string, 4>{"a", "b", "c", "d"}));
+	vec.insert(vec.begin(), 2, "z");
+	EXPECT_EQ(vec, (ccat::small_vector<std::string, 4>{"z", "z", "a", "b", "c", "d"}));
+	vec.emplace(vec.begin() + 2, 3, 'y');
+	EXPECT_EQ(vec[2], "yyy");
+	vec.erase(vec.begin(), vec.begin() + 3);
+	EXPECT_EQ(vec, (ccat::small_vector<std::string, 4>{"a", "b", "c", "d"}));
+	erase(vec, "b");
+	EXPECT_EQ(vec, (ccat::small_vector<std::string, 4>{"a", "c", "d"}));
+	vec.resize(6, "e");
+	EXPECT_EQ(vec.back(), "e");
+	vec.resize(1);
+	EXPECT_EQ(vec, (ccat::small_vector<std::string, 4>{"a"}));
+
+	char letter = 'p';
+	vec.push_back("z");
+	vec.reserve(8);
+	vec.insert_range(vec.begin() + 1, std::views::counted(letter_input{&letter}, 3)); // sized but single pass, more than the tail
+	EXPECT_EQ(vec, (ccat::small_vector<std::string, 4>{"a", "p", "q", "r", "z"}));
+}
+
+TEST_F(test_small_vector, copy_move_and_swap) {
+	ccat::small_vector<std::string, 2> small{"x"};
+	ccat::small_vector<std::string, 2> large{"a", "b", "c"};
+	auto small_copy = small;
+	auto large_copy = large;
+	EXPECT_EQ(small_copy, small);
+	EXPECT_EQ(large_copy, large);
+
+	auto moved_small = std::move(small_copy);
+	EXPECT_TRUE(moved_small.is_inline());
+	EXPECT_TRUE(small_copy.empty());
+	auto moved_large = std::move(large_copy);
+	EXPECT_FALSE(moved_large.is_inline());
+	EXPECT_TRUE(large_copy.empty());
+	EXPECT_TRUE(large_copy.is_inline());
+
+	moved_small.swap(moved_large);
+	EXPECT_EQ(moved_small, large);
+	EXPECT_EQ(moved_large, small);
+	moved_large.swap(moved_small);
+	EXPECT_EQ(moved_small, small);
+	EXPECT_EQ(moved_large, large);
+
+	moved_small = large;
+	EXPECT_EQ(moved_small, large);
+	moved_large = std::move(small);
+	EXPECT_EQ(moved_large, (ccat::small_vector<std::string, 2>{"x"}));
+}
+
+TEST_F(test_small_vector, allocate_at_least) {
+	ccat::small_vector<int, 4, generous_allocator<int>> vec{1, 2, 3, 4};
+	vec.push_back(5);
+	EXPECT_FALSE(vec.is_inline());
+	EXPECT_EQ(vec.capacity(), 13u);
+	vec.shrink_to_fit();
+	EXPECT_EQ(vec.capacity(), 12u);
+	vec.erase(vec.begin() + 3, vec.end());
+	vec.shrink_to_fit();
+	EXPECT_TRUE(vec.is_inline());
+	EXPECT_EQ(vec.capacity(), 4u);
+	EXPECT_EQ(vec, (ccat::small_vector<int, 4, generous_allocator<int>>{1, 2, 3}));
+}
+
+auto main(int argc, char* argv[]) ->int {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
\ No newline at end of file
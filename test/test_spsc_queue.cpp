@@ -0,0 +1,80 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stltoys/spsc_queue.h>
+#include <gtest/gtest.h>
+
+class test_spsc_queue : public testing::Test {};
+
+TEST_F(test_spsc_queue, single_thread) {
+	ccat::spsc_queue<std::string> queue{3};
+	EXPECT_EQ(queue.capacity(), 4u);
+	EXPECT_TRUE(queue.empty());
+	EXPECT_TRUE(queue.try_push("a"));
+	EXPECT_TRUE(queue.try_emplace(2, 'b'));
+	queue.push("c");
+	queue.emplace("d");
+	EXPECT_FALSE(queue.try_push("e"));
+	EXPECT_EQ(queue.size(), 4u);
+	EXPECT_EQ(queue.front(), "a");
+	queue.pop();
+	std::string out;
+	EXPECT_TRUE(queue.try_pop(out));
+	EXPECT_EQ(out, "bb");
+
+	std::string more[] = {"e", "f", "g"};
+	EXPECT_EQ(queue.try_push_n(std::begin(more), 3), 2u); // only two slots are free
+	std::vector<std::string> popped;
+	EXPECT_EQ(queue.try_pop_n(std::back_inserter(popped), 10), 4u);
+	EXPECT_EQ(popped, (std::vector<std::string>{"c", "d", "e", "f"}));
+	EXPECT_FALSE(queue.try_pop(out));
+	EXPECT_THROW(ccat::spsc_queue<int>{0}, std::length_error);
+}
+
+TEST_F(test_spsc_queue, destroys_leftovers) {
+	auto counter = std::make_shared<int>(0);
+	{
+		ccat::spsc_queue<std::shared_ptr<int>> queue{8};
+		for (int i = 0; i < 5; ++i) queue.push(counter);
+		queue.pop();
+		EXPECT_EQ(counter.use_count(), 5);
+	}
+	EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST_F(test_spsc_queue, two_threads) {
+	constexpr int count = 1000000;
+	ccat::spsc_queue<int> queue{64};
+	std::thread producer{[&] {
+		for (int i = 0; i < count;) {
+			if (i % 3 == 0) {
+				int batch[] = {i, i + 1, i + 2};
+				auto pushed = queue.try_push_n(batch, std::min(3, count - i));
+				if (pushed == 0) std::this_thread::yield();
+				i += static_cast<int>(pushed);
+			}
+			else {
+				queue.push(i++);
+			}
+		}
+	}};
+	int expected = 0;
+	while (expected < count) {
+		int batch[16];
+		auto n = queue.try_pop_n(batch, 16);
+		if (n == 0) std::this_thread::yield();
+		for (std::size_t i = 0; i < n; ++i) {
+			EXPECT_EQ(batch[i], expected);
+			++expected;
+		}
+	}
+	producer.join();
+	EXPECT_TRUE(queue.empty());
+}
+
+auto main(int argc, char* argv[]) ->int {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -1,8 +1,47 @@
 #include <gtest/gtest.h>
+#include "test_allocators.h"
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <list>
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <ranges>
 #include <stltoys/basic_string.h>
+#include <stltoys/str_cat.h>
+#include <stltoys/arena_allocator.h>
 
 static_assert(std::ranges::range<ccat::string>);
+static_assert(ccat::string_view{"compile-time search"}.find("time") == 8);
+static_assert(ccat::string_view{"compile-time search"}.rfind("e") == 14);
+static_assert(ccat::string_view{"compile-time search"}.find_last_not_of("arch") == 14);
+static_assert(ccat::string_view{"\x7f"} < ccat::string_view{"\x80"});
+static_assert(ccat::u16string_view{u"compile-time"}.size() == 12 && ccat::u32string_view{U"time"}.find(U'm') == 2);
+static_assert([] {
+	ccat::compact_string empty;
+	ccat::compact_string with_alloc{std::allocator<char>{}};
+	return empty.c_str()[0] == '\0' && with_alloc.c_str()[0] == '\0';
+}());
+static_assert([] {
+	ccat::compact_string str{"compile"};
+	str += "-time strings are always long";
+	ccat::compact_string other = std::move(str);
+	return other.size() + str.size();
+}() == 36);
+static_assert([] {
+	ccat::compact_string head{"compile"};
+	ccat::compact_string res = head + '-' + "time" + ccat::compact_string{" concat"};
+	return res.size() + ccat::str_cat(res, ccat::string_view{"!"}, '?').size();
+}() == 19 + 21);
+static_assert([] {
+	ccat::compact_string str{"abcdef"};
+	str.insert(str.begin() + 1, str.begin(), str.end());
+	char tail[] = {'x', 'y'};
+	str.append_range(tail);
+	return str == "aabcdefbcdefxy";
+}());
 
 class string_test : public testing::Test {};
 
@@ -23,14 +62,212 @@ TEST_F(string_test, insert) {
 	EXPECT_EQ(str, "hello world");
 }
 
+TEST_F(string_test, insert_ranges) {
+	std::list<char> chars{'a', 'b', 'c'};
+	ccat::string str{"0123"};
+	EXPECT_EQ(*str.insert(str.begin() + 2, chars.begin(), chars.end()), 'a');
+	EXPECT_EQ(str, "01abc23");
+	str.append(chars.begin(), chars.end()).append_range(std::string_view{"xyz"});
+	EXPECT_EQ(str, "01abc23abcxyz");
+	str.insert_range(str.begin(), chars);
+	EXPECT_EQ(str, "abc01abc23abcxyz");
+	str.replace(str.begin(), str.begin() + 5, chars.begin(), chars.end());
+	EXPECT_EQ(str, "abcabc23abcxyz");
+	str.assign_range(std::vector<char>{'q'});
+	EXPECT_EQ(str, "q");
+
+	std::istringstream in{"streamed input"};
+	str.insert(str.begin(), std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+	EXPECT_EQ(str, "streamed inputq");
+	in = std::istringstream{"!!"};
+	str.append(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+	EXPECT_EQ(str, "streamed inputq!!");
+	in = std::istringstream{"<>"};
+	str.replace(str.begin() + 8, str.end() - 3, std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+	EXPECT_EQ(str, "streamed<>q!!");
+
+	ccat::string self{"abcdef"}; // ranges that view the string itself
+	self.insert(self.begin() + 1, self.begin(), self.end());
+	EXPECT_EQ(self, "aabcdefbcdef");
+	self.reserve(100);
+	self.insert(self.begin() + 2, self.begin(), self.begin() + 4);
+	EXPECT_EQ(self, "aaaabcbcdefbcdef");
+	self.replace(self.begin(), self.begin() + 4, self.end() - 3, self.end());
+	EXPECT_EQ(self, "defbcbcdefbcdef");
+	self.assign(self.begin() + 10, self.end());
+	EXPECT_EQ(self, "bcdef");
+	ccat::string reversed{"abcd"}; // non-contiguous iterators over the string itself
+	reversed.reserve(20);
+	reversed.insert(reversed.begin() + 1, reversed.rbegin(), reversed.rend());
+	EXPECT_EQ(reversed, "adcbabcd");
+	ccat::string replaced{"abcd"};
+	replaced.reserve(20);
+	replaced.replace(replaced.begin(), replaced.begin() + 1, replaced.rbegin(), replaced.rend());
+	EXPECT_EQ(replaced, "dcbabcd");
+	replaced.append(replaced.rbegin(), replaced.rend());
+	EXPECT_EQ(replaced, "dcbabcddcbabcd");
+	replaced.insert_range(replaced.begin(), replaced | std::views::take(3) | std::views::reverse);
+	EXPECT_EQ(replaced, "bcddcbabcddcbabcd");
+
+	ccat::string built(chars.begin(), chars.end());
+	EXPECT_EQ(built, "abc");
+	std::vector<int> codes(1000, 'z');
+	built.append(codes.begin(), codes.end());
+	EXPECT_EQ(built.size(), 1003u);
+	EXPECT_EQ(built.find_first_not_of('z', 3), ccat::string::npos);
+}
+
 TEST_F(string_test, find) {
 	ccat::string str{"hello world hello c++"};
-	EXPECT_EQ(str.find("llo"), 2);
-	EXPECT_EQ(str.rfind("el", 12), 1);
+	EXPECT_EQ(str.find("llo"), 2u);
+	EXPECT_EQ(str.rfind("el", 12), 1u);
 	EXPECT_EQ(str.find_first_of("ABab"), ccat::string::npos);
-	EXPECT_EQ(str.find_first_not_of("hel"), 4);
-	EXPECT_EQ(str.find_last_of('o'), 16);
-	EXPECT_EQ(str.find_last_not_of(" c+lo"), 13);
+	EXPECT_EQ(str.find_first_not_of("hel"), 4u);
+	EXPECT_EQ(str.find_last_of('o'), 16u);
+	EXPECT_EQ(str.find_last_not_of(" c+lo"), 13u);
+}
+
+TEST_F(string_test, find_agrees_with_std) {
+	std::string text;
+	for (int i = 0; i < 3000; ++i) text += "abcab"[(i * 7 + i / 13) % 5];
+	text += "the needle at the very end of the haystack";
+	ccat::string_view view{text.data(), text.size()};
+	std::string_view expected{text};
+	for (std::size_t len : {0, 1, 2, 3, 5, 15, 16, 17, 31, 32, 33, 42, 64}) {
+		for (std::size_t from : {std::size_t{0}, text.size() / 3, text.size() - len}) {
+			auto needle = expected.substr(from, len);
+			ccat::string_view pat{needle.data(), needle.size()};
+			for (std::size_t pos : {std::size_t{0}, std::size_t{1}, text.size() / 2, text.size(), ccat::string_view::npos}) {
+				EXPECT_EQ(view.find(pat, pos), expected.find(needle, pos)) << len << ' ' << from << ' ' << pos;
+				EXPECT_EQ(view.rfind(pat, pos), expected.rfind(needle, pos)) << len << ' ' << from << ' ' << pos;
+			}
+		}
+	}
+	EXPECT_EQ(view.find("abcabd"), ccat::string_view::npos);
+	EXPECT_EQ(view.find("the needle at the very end of the haystack!"), ccat::string_view::npos);
+	EXPECT_EQ(ccat::string{"hello hello"}.find("llo", 3), 8u);
+
+	std::wstring wide(1000, L'x');
+	wide += L"\u0100x\u0200";
+	ccat::wstring_view wview{wide.data(), wide.size()};
+	EXPECT_EQ(wview.find(L"\u0100x\u0200"), 1000u);
+	EXPECT_EQ(wview.rfind(L"x\u0100"), 999u);
+	EXPECT_EQ(wview.find(std::wstring(40, L'x').c_str()), 0u);
+	EXPECT_EQ(wview.rfind(std::wstring(40, L'x').c_str()), 960u);
+}
+
+TEST_F(string_test, find_of_agrees_with_std) {
+	std::string text;
+	for (int i = 0; i < 300; ++i) text += static_cast<char>((i * 37 + i / 7) % 256);
+	ccat::string_view view{text.data(), text.size()};
+	std::string_view expected{text};
+	std::string sets[] = {"", "a", " \t\n,;", "0123456789", std::string{"\x80\xff\x7f\x01"}, std::string(1, '\0') + "z"};
+	std::string every;
+	for (int c = 0; c < 256; ++c) every += static_cast<char>(c);
+	for (auto& set : {sets[0], sets[1], sets[2], sets[3], sets[4], sets[5], every}) {
+		ccat::string_view chars{set.data(), set.size()};
+		for (std::size_t pos : {std::size_t{0}, std::size_t{5}, std::size_t{150}, std::size_t{299}, ccat::string_view::npos}) {
+			EXPECT_EQ(view.find_first_of(chars, pos), expected.find_first_of(set, pos)) << set << ' ' << pos;
+			EXPECT_EQ(view.find_last_of(chars, pos), expected.find_last_of(set, pos)) << set << ' ' << pos;
+			EXPECT_EQ(view.find_first_not_of(chars, pos), expected.find_first_not_of(set, pos)) << set << ' ' << pos;
+			EXPECT_EQ(view.find_last_not_of(chars, pos), expected.find_last_not_of(set, pos)) << set << ' ' << pos;
+		}
+	}
+
+	std::wstring wide = L"key\u0100=value;\u0200other";
+	ccat::wstring_view wview{wide.data(), wide.size()};
+	EXPECT_EQ(wview.find_first_of(L"=;"), 4u);
+	EXPECT_EQ(wview.find_first_of(L"\u0200\u0100"), 3u);
+	EXPECT_EQ(wview.find_first_of(L"\u0300"), ccat::wstring_view::npos); // shares a bucket with `\u0100` and `\u0200`
+	EXPECT_EQ(wview.find_last_not_of(L"\u0300other"), 11u);
+
+	std::u32string text32; // sets small enough for the inline table and big enough for a heap one, with duplicates
+	for (char32_t i = 0; i < 500; ++i) text32 += U'\u4e00' + (i * 7) % 300;
+	ccat::u32string_view view32{text32.data(), text32.size()};
+	for (std::size_t size : {2, 40, 64, 65, 250, 300}) {
+		std::u32string set32;
+		for (std::size_t i = 0; i < size; ++i) set32 += U'\u4e00' + (i * 13) % 280;
+		ccat::u32string_view chars{set32.data(), set32.size()};
+		for (std::size_t pos : {std::size_t{0}, std::size_t{123}, ccat::u32string_view::npos}) {
+			EXPECT_EQ(view32.find_first_of(chars, pos), std::u32string_view{text32}.find_first_of(set32, pos)) << size;
+			EXPECT_EQ(view32.find_last_of(chars, pos), std::u32string_view{text32}.find_last_of(set32, pos)) << size;
+			EXPECT_EQ(view32.find_first_not_of(chars, pos), std::u32string_view{text32}.find_first_not_of(set32, pos)) << size;
+			EXPECT_EQ(view32.find_last_not_of(chars, pos), std::u32string_view{text32}.find_last_not_of(set32, pos)) << size;
+		}
+	}
+}
+
+TEST_F(string_test, compare_binary_keys) {
+	ccat::string a{"key\0a", 6};
+	ccat::string b{"key\0b", 6};
+	EXPECT_LT(a, b);
+	EXPECT_NE(a, b);
+	EXPECT_LT(ccat::string{"\x7f"}, ccat::string{"\x80"}); // characters compare as unsigned
+	EXPECT_GT(a.compare(b.substr(0, 4)), 0);
+
+	std::string long_text(1000, 'q');
+	ccat::string c{long_text.data(), long_text.size()};
+	ccat::string d{c};
+	EXPECT_EQ(c, d);
+	for (std::size_t i : {0, 15, 16, 31, 32, 500, 999}) {
+		d[i] = 'r';
+		EXPECT_NE(c, d) << i;
+		EXPECT_LT(c, d) << i;
+		d[i] = 'q';
+	}
+	EXPECT_EQ(c, d);
+}
+
+TEST_F(string_test, unicode_char_types) {
+	ccat::u8string u8{u8"gr\u00fc\u00dfe"};
+	EXPECT_EQ(u8.size(), 7u);
+	EXPECT_EQ(u8.find(u8"\u00df"), 4u);
+	EXPECT_LT(u8, ccat::u8string{u8"gr\u00fc\u00dff"});
+
+	for (std::size_t skip = 0; skip < 8; ++skip) { // every alignment of the terminator within a block
+		std::u16string text(skip, u'-');
+		text += u"\u00e9t\u00e9 \U0001f600 utf-16 text, long enough to span several blocks";
+		ccat::u16string u16{text.c_str()};
+		EXPECT_EQ(u16.size(), text.size());
+		EXPECT_EQ(u16.find(u'u'), text.find(u'u'));
+		EXPECT_EQ(u16.find(u"blocks"), text.find(u"blocks"));
+		EXPECT_EQ(u16.find_first_of(u"\U0001f600"), text.find_first_of(u"\U0001f600"));
+		EXPECT_EQ(u16.rfind(u'e'), text.rfind(u'e'));
+	}
+	EXPECT_LT(ccat::u16string{u"abcdefghijklmnopq"}, ccat::u16string{u"abcdefghijklmnopr"});
+	EXPECT_GT(ccat::u16string{u"\uffff"}, ccat::u16string{u"\u0041"}); // no sign trouble in the upper half
+
+	std::u32string wide32(100, U'x');
+	wide32 += U"\U0001f600y";
+	ccat::u32string u32{wide32.c_str()};
+	EXPECT_EQ(u32.size(), 102u);
+	EXPECT_EQ(u32.find(U'\U0001f600'), 100u);
+	EXPECT_EQ(u32.find(U"xy"), ccat::u32string::npos);
+	EXPECT_LT(u32, ccat::u32string(ccat::u32string{wide32.c_str()} + U'z'));
+	EXPECT_EQ(std::char_traits<char32_t>::eof(), ccat::char_traits<char32_t>::eof());
+	EXPECT_EQ(std::char_traits<char16_t>::eof(), ccat::char_traits<char16_t>::eof());
+}
+
+TEST_F(string_test, fill) {
+	ccat::string str(40, 'x');
+	EXPECT_EQ(str, ccat::string_view{std::string(40, 'x').c_str()});
+	str.resize(50, 'y');
+	str.insert(3, 5, 'z');
+	EXPECT_EQ(str.substr(0, 9), "xxxzzzzzx");
+	EXPECT_EQ(str.find_first_not_of('y', 45), ccat::string::npos);
+
+	for (std::size_t count : {0, 1, 7, 8, 9, 33}) {
+		ccat::u16string u16(count, u'\u00e9');
+		ccat::u32string u32(count, U'\U0001f600');
+		ccat::wstring wide(count, L'w');
+		EXPECT_EQ(u16.find_first_not_of(u'\u00e9'), ccat::u16string::npos);
+		EXPECT_EQ(u32.find_first_not_of(U'\U0001f600'), ccat::u32string::npos);
+		EXPECT_EQ(wide.find_first_not_of(L'w'), ccat::wstring::npos);
+		EXPECT_EQ(u16.size() + u32.size() + wide.size(), 3 * count);
+		u16.resize(count + 20, u'a');
+		EXPECT_EQ(u16.find(u'a'), count);
+		EXPECT_EQ(u16.c_str()[count + 20], u'\0');
+	}
 }
 
 TEST_F(string_test, resize_reserve_and_shrink_to_fit) {
@@ -38,10 +275,190 @@ TEST_F(string_test, resize_reserve_and_shrink_to_fit) {
 	EXPECT_EQ(str, "+++++++++++++++");
 	str.resize(20, '-');
 	EXPECT_EQ(str, "+++++++++++++++-----");
-	EXPECT_EQ(str.size(), 20);
-	EXPECT_EQ(str.capacity(), 22);
+	EXPECT_EQ(str.size(), 20u);
+	EXPECT_EQ(str.capacity(), 22u);
 	str.shrink_to_fit();
-	EXPECT_EQ(str.capacity(), 20);
+	EXPECT_EQ(str.capacity(), 20u);
+}
+
+TEST_F(string_test, resize_and_overwrite) {
+	ccat::string str{"key="};
+	str.resize_and_overwrite(64, [](char* buf, std::size_t n) {
+		EXPECT_EQ(n, 64u);
+		std::memcpy(buf + 4, "value", 5);
+		return 9;
+	});
+	EXPECT_EQ(str, "key=value");
+	EXPECT_EQ(str.size(), 9u);
+	EXPECT_GE(str.capacity(), 64u);
+	str.resize_and_overwrite(3, [](char*, std::size_t) {
+		return 3;
+	});
+	EXPECT_EQ(str, "key");
+}
+
+TEST_F(string_test, arena_allocator) {
+	using arena_string = ccat::basic_string<char, ccat::char_traits<char>, ccat::arena_allocator<char>>;
+	alignas(std::max_align_t) std::byte buffer[1024];
+	ccat::monotonic_arena arena{buffer, sizeof(buffer)};
+	auto in_buffer = [&](const auto& str) {
+		auto p = reinterpret_cast<const std::byte*>(str.data());
+		return std::less_equal<>{}(buffer, p) && std::less<>{}(p, buffer + sizeof(buffer));
+	};
+	for (int request = 0; request < 3; ++request) { // each round parses into the arena and frees it with one `reset`
+		{
+			arena_string line("GET /index.html HTTP/1.1 with some headers", arena);
+			auto method = line.substr(0, 3);
+			auto path = line.substr(4, 11);
+			path += "?query=string&more=values";
+			EXPECT_TRUE(in_buffer(line) && in_buffer(path));
+			EXPECT_EQ(method.get_allocator(), line.get_allocator());
+			EXPECT_EQ(path, "/index.html?query=string&more=values");
+		}
+		arena.reset();
+		EXPECT_EQ(arena.remaining(), sizeof(buffer));
+	}
+
+	ccat::monotonic_arena other_arena;
+	arena_string a(40, 'a', arena);
+	arena_string b(50, 'b', other_arena);
+	arena_string c = a; // copies stay in the arena
+	EXPECT_EQ(c.get_allocator().arena(), &arena);
+	b = a; // allocators never propagate: `b` copies into its own arena
+	EXPECT_EQ(b.get_allocator().arena(), &other_arena);
+	EXPECT_EQ(b, a);
+	b = std::move(c);
+	EXPECT_EQ(b.get_allocator().arena(), &other_arena);
+	EXPECT_FALSE(in_buffer(b));
+	arena_string d(std::move(b), arena); // a different allocator: the characters are copied
+	EXPECT_TRUE(in_buffer(d));
+	EXPECT_EQ(d, a);
+	a.swap(d);
+	EXPECT_EQ(a, d);
+
+	using compact_arena_string = ccat::basic_string<char, ccat::char_traits<char>, ccat::arena_allocator<char>, ccat::growth_policy::one_and_half, ccat::string_layout::compact>;
+	compact_arena_string e("a long string that lives in the arena", other_arena);
+	compact_arena_string f("short", arena);
+	f = std::move(e);
+	EXPECT_EQ(f.get_allocator().arena(), &arena);
+	EXPECT_EQ(f, "a long string that lives in the arena");
+	EXPECT_TRUE(in_buffer(f));
+}
+
+TEST_F(string_test, growth_policy) {
+	ccat::basic_string<char, ccat::char_traits<char>, std::allocator<char>, ccat::growth_policy::doubling> str(100, 'a');
+	str.push_back('b');
+	EXPECT_EQ(str.capacity(), 200u);
+	str.append(99, 'c');
+	str.push_back('d');
+	EXPECT_EQ(str.capacity(), 400u);
+	EXPECT_EQ(str.size(), 201u);
+	EXPECT_EQ(str.back(), 'd');
+	str.reserve(1000);
+	str.append(1000, 'e'); // grows from the size, not from the reserved capacity
+	EXPECT_EQ(str.capacity(), 1201u);
+
+	decltype(str) appended(201, 'a');
+	appended.reserve(1000);
+	ccat::str_append(appended, ccat::string_view{str}.substr(201));
+	EXPECT_EQ(appended.capacity(), str.capacity()); // str_append grows like append
+}
+
+TEST_F(string_test, compact_layout) {
+	static_assert(sizeof(ccat::compact_string) == 3 * sizeof(void*));
+	ccat::compact_string str;
+	EXPECT_EQ(str.capacity(), 22u);
+	EXPECT_EQ(str.c_str()[0], '\0');
+	for (int i = 0; i < 22; ++i) str.push_back(static_cast<char>('a' + i));
+	EXPECT_EQ(str.capacity(), 22u); // still inline
+	EXPECT_EQ(str, "abcdefghijklmnopqrstuv");
+	str.push_back('w');
+	EXPECT_GT(str.capacity(), 22u);
+	EXPECT_EQ(str, "abcdefghijklmnopqrstuvw");
+	str.insert(3, str.c_str(), 5); // the source lives in the buffer being grown
+	EXPECT_EQ(str, "abcabcdedefghijklmnopqrstuvw");
+	str.erase(10);
+	str.shrink_to_fit();
+	EXPECT_EQ(str.capacity(), 22u);
+	EXPECT_EQ(str, "abcabcdede");
+
+	ccat::compact_string long_one(100, 'x');
+	ccat::compact_string copy{long_one};
+	ccat::compact_string moved{std::move(copy)};
+	EXPECT_TRUE(copy.empty());
+	EXPECT_EQ(moved, long_one);
+	moved.swap(str);
+	EXPECT_EQ(moved, "abcabcdede");
+	EXPECT_EQ(str.size(), 100u);
+	str = std::move(moved);
+	EXPECT_EQ(str, "abcabcdede");
+	str.resize(40, 'y');
+	str.resize(5);
+	EXPECT_EQ(str, "abcab");
+	str.resize_and_overwrite(30, [](char* buf, std::size_t n) {
+		std::memset(buf, 'z', n);
+		return n;
+	});
+	EXPECT_EQ(str.find_first_not_of('z', 5), ccat::compact_string::npos);
+
+	ccat::basic_string<char16_t, ccat::char_traits<char16_t>, std::allocator<char16_t>, ccat::growth_policy::one_and_half, ccat::string_layout::compact> u16{u"0123456789"};
+	EXPECT_EQ(u16.capacity(), 10u);
+	u16 += u'a';
+	EXPECT_EQ(u16, u"0123456789a");
+}
+
+TEST_F(string_test, concatenation) {
+	using counted_string = ccat::basic_string<char, ccat::char_traits<char>, counting_allocator<char>>;
+	counted_string a(40, 'a'), b(40, 'b');
+	counting_allocator<char>::allocations = 0;
+	counted_string res = a + "-" + b + '-' + ccat::string_view{"view"} + a;
+	EXPECT_EQ(counting_allocator<char>::allocations, 1u);
+	EXPECT_EQ(res.size(), 40u + 1 + 40 + 1 + 4 + 40);
+	EXPECT_EQ(std::string(res.data(), res.size()), std::string(40, 'a') + "-" + std::string(40, 'b') + "-view" + std::string(40, 'a'));
+
+	counting_allocator<char>::allocations = 0;
+	counted_string moved = counted_string(100, 'x') + b + "tail";
+	EXPECT_EQ(counting_allocator<char>::allocations, 2u); // the temporary, then one regrowth of its buffer
+	EXPECT_EQ(moved.size(), 144u);
+
+	ccat::string s{"abc"};
+	EXPECT_EQ(ccat::string(s + s + s), "abcabcabc");
+	EXPECT_EQ(ccat::string('<' + s + '>'), "<abc>");
+	EXPECT_EQ((s + "def").size(), 6u);
+	EXPECT_LT(ccat::string(s + "a"), ccat::string(s + "b"));
+	s = s + s; // the operands view the string being assigned
+	EXPECT_EQ(s, "abcabc");
+
+	using node = decltype(s + "!"); // a node must be consumed right away, before its operands can change
+	static_assert(!std::copy_constructible<node>);
+	static_assert(!std::convertible_to<node&, ccat::string>);
+	static_assert(std::convertible_to<node, ccat::string>);
+
+	ccat::string same{"abc"}; // a moved operand that the other one views
+	ccat::string both = std::move(same) + same;
+	EXPECT_EQ(both, "abcabc");
+	ccat::string long_same(40, 'l');
+	both = long_same.c_str() + std::move(long_same);
+	EXPECT_EQ(both, ccat::string(80, 'l'));
+	ccat::string twice{"xy"};
+	both = std::move(twice) + std::move(twice);
+	EXPECT_EQ(both, "xyxy");
+
+	auto str = ccat::str_cat("x=", ccat::string{"1"}, ',', ccat::string_view{"y=2"});
+	static_assert(std::same_as<decltype(str), ccat::string>);
+	EXPECT_EQ(str, "x=1,y=2");
+	EXPECT_EQ(ccat::str_cat(U"wide", U'!'), U"wide!");
+
+	ccat::string dst{"0123456789"};
+	dst.reserve(64);
+	auto* data = dst.data();
+	ccat::str_append(dst, dst, '|', ccat::string_view{dst}.substr(0, 3));
+	EXPECT_EQ(dst.data(), data); // written into spare capacity
+	EXPECT_EQ(dst, "01234567890123456789|012");
+	dst.shrink_to_fit();
+	ccat::str_append(dst, dst, dst.c_str());
+	EXPECT_EQ(dst.size(), 72u);
+	EXPECT_EQ(dst.substr(48), "01234567890123456789|012");
 }
 
 TEST_F(string_test, assign) {
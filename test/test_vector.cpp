@@ -1,10 +1,44 @@
 #include <iostream>
+#include <forward_list>
+#include <sstream>
 #include <stltoys/vector.h>
 #include <stltoys/array.h>
+#include <stltoys/arena_allocator.h>
+#if defined(__linux__)
+#include <stltoys/mmap_allocator.h>
+#endif
 #include <gtest/gtest.h>
+#include "test_allocators.h"
+#include "test_iterators.h"
 
 static_assert(std::ranges::contiguous_range<ccat::vector<int>>);
 
+namespace {
+	struct relocatable_handle {
+		relocatable_handle(int v) : ptr(new int(v)) {}
+		relocatable_handle(const relocatable_handle& other) : ptr(new int(*other.ptr)) {}
+		relocatable_handle(relocatable_handle&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {}
+		auto operator= (relocatable_handle other) noexcept ->relocatable_handle& {
+			std::swap(ptr, other.ptr);
+			return *this;
+		}
+		~relocatable_handle() {
+			delete ptr;
+		}
+		friend auto operator== (const relocatable_handle& lhs, const relocatable_handle& rhs) ->bool {
+			return *lhs.ptr == *rhs.ptr;
+		}
+		int* ptr;
+	};
+}
+
+template<>
+struct ccat::is_trivially_relocatable<relocatable_handle> : std::true_type {};
+
+static_assert(ccat::is_trivially_relocatable_v<int>);
+static_assert(!ccat::is_trivially_relocatable_v<std::string>);
+static_assert(ccat::concepts::trivially_relocatable_into<relocatable_handle, ccat::vector<relocatable_handle>>);
+
 class test_vector : public testing::Test {};
 
 TEST_F(test_vector, constructors) {
@@ -99,6 +133,202 @@ TEST_F(test_vector, ranges_and_views) {
 	}
 }
 
+TEST_F(test_vector, trivially_relocatable) {
+	ccat::vector<relocatable_handle> vec;
+	for (int i = 0; i < 100; ++i) vec.emplace_back(i);
+	for (int i = 0; i < 100; ++i) EXPECT_EQ(*vec[i].ptr, i);
+	vec.insert(vec.begin() + 1, 3, relocatable_handle{-1});
+	vec.emplace(vec.begin(), -2);
+	vec.erase(vec.begin() + 10, vec.begin() + 50);
+	EXPECT_EQ(vec.size(), 64u);
+	EXPECT_EQ(*vec[0].ptr, -2);
+	EXPECT_EQ(*vec[1].ptr, 0);
+	EXPECT_EQ(*vec[2].ptr, -1);
+	EXPECT_EQ(*vec[4].ptr, -1);
+	EXPECT_EQ(*vec[5].ptr, 1);
+	EXPECT_EQ(*vec[10].ptr, 46);
+	EXPECT_EQ(*vec.back().ptr, 99);
+	vec.resize(200, relocatable_handle{7});
+	EXPECT_EQ(*vec.back().ptr, 7);
+	vec.shrink_to_fit();
+	EXPECT_EQ(vec.capacity(), 200u);
+}
+
+TEST_F(test_vector, block_insert) {
+	ccat::vector<std::string> vec{"a", "b", "c", "d"};
+	vec.reserve(32);
+	vec.insert(vec.begin() + 3, 2, "x"); // fewer than the tail
+	EXPECT_EQ(vec, (ccat::vector<std::string>{"a", "b", "c", "x", "x", "d"}));
+	vec.insert(vec.begin() + 5, {"p", "q", "r"}); // more than the tail
+	EXPECT_EQ(vec, (ccat::vector<std::string>{"a", "b", "c", "x", "x", "p", "q", "r", "d"}));
+	vec.insert(vec.begin(), 30, vec[2]); // reallocates, the value lives in the vector
+	EXPECT_EQ(vec.size(), 39u);
+	EXPECT_EQ(vec[29], "c");
+	EXPECT_EQ(vec[30], "a");
+	EXPECT_EQ(vec.back(), "d");
+
+	std::istringstream in{"4 5 6"};
+	ccat::vector<int> ints{1, 2, 3, 7, 8};
+	ints.insert(ints.begin() + 3, std::istream_iterator<int>{in}, std::istream_iterator<int>{});
+	EXPECT_EQ(ints, (ccat::vector{1, 2, 3, 4, 5, 6, 7, 8}));
+	ints.insert_range(ints.begin() + 1, std::views::iota(10, 13));
+	EXPECT_EQ(ints, (ccat::vector{1, 10, 11, 12, 2, 3, 4, 5, 6, 7, 8}));
+	ints.insert(ints.begin() + 2, 2, ints[0]);
+	EXPECT_EQ(ints, (ccat::vector{1, 10, 1, 1, 11, 12, 2, 3, 4, 5, 6, 7, 8}));
+	ints.insert(ints.end(), 2, 9);
+	EXPECT_EQ(ints.back(), 9);
+	EXPECT_EQ(ints.size(), 15u);
+
+	char letter = 'p';
+	ccat::vector<std::string> strs{"a", "b", "z"};
+	strs.reserve(16);
+	strs.insert_range(strs.begin() + 2, std::views::counted(letter_input{&letter}, 3)); // sized but single pass, more than the tail
+	EXPECT_EQ(strs, (ccat::vector<std::string>{"a", "b", "p", "q", "r", "z"}));
+}
+
+TEST_F(test_vector, resize_for_overwrite) {
+	ccat::vector vec{1, 2, 3};
+	vec.resize_for_overwrite(1000);
+	EXPECT_EQ(vec.size(), 1000u);
+	EXPECT_EQ(vec[2], 3);
+	for (int i = 3; i < 1000; ++i) vec[i] = i;
+	EXPECT_EQ(vec.back(), 999);
+	vec.resize_for_overwrite(2);
+	EXPECT_EQ(vec, (ccat::vector{1, 2}));
+
+	ccat::vector<std::string> strs{"a"};
+	strs.resize_for_overwrite(3);
+	EXPECT_EQ(strs, (ccat::vector<std::string>{"a", "", ""}));
+}
+
+TEST_F(test_vector, bulk_append) {
+	using alloc_type = counting_allocator<int>;
+	std::forward_list<int> list{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+	alloc_type::allocations = 0;
+	ccat::vector<int, alloc_type> vec1(list.begin(), list.end());
+	EXPECT_EQ(alloc_type::allocations, 1u);
+	EXPECT_EQ(vec1.size(), 10u);
+	EXPECT_EQ(vec1.back(), 10);
+
+	alloc_type::allocations = 0;
+	ccat::vector<int, alloc_type> vec2;
+	vec2.append_range(std::views::iota(0, 100000));
+	EXPECT_EQ(alloc_type::allocations, 1u);
+	EXPECT_EQ(vec2.capacity(), 100000u);
+	EXPECT_EQ(vec2[4242], 4242);
+
+	alloc_type::allocations = 0;
+	ccat::vector<int, alloc_type> vec3{vec2};
+	EXPECT_EQ(alloc_type::allocations, 1u);
+	EXPECT_EQ(vec3, vec2);
+
+	std::istringstream in{"1 2 3"};
+	ccat::vector<int> vec4(std::istream_iterator<int>{in}, std::istream_iterator<int>{});
+	EXPECT_EQ(vec4, (ccat::vector{1, 2, 3}));
+}
+
+TEST_F(test_vector, growth_policy) {
+	ccat::vector<int, std::allocator<int>, ccat::growth_policy::doubling> vec;
+	std::vector<std::size_t> capacities;
+	for (int i = 0; i < 100; ++i) {
+		vec.push_back(i);
+		if (capacities.empty() || capacities.back() != vec.capacity()) capacities.push_back(vec.capacity());
+	}
+	EXPECT_EQ(capacities, (std::vector<std::size_t>{1, 2, 4, 8, 16, 32, 64, 128}));
+	EXPECT_EQ(ccat::erase(vec, 42), 1u);
+
+	ccat::vector<int, std::allocator<int>, ccat::growth_policy::fixed_increment<10>> vec2(5);
+	EXPECT_EQ(vec2.capacity(), 10u);
+	vec2.append_range(std::views::iota(0, 6));
+	EXPECT_EQ(vec2.capacity(), 20u);
+	vec2.append_range(std::views::iota(0, 20)); // the final size beats one increment
+	EXPECT_EQ(vec2.capacity(), 31u);
+
+	ccat::vector<char, std::allocator<char>, ccat::growth_policy::page_rounded<>> vec3(5000);
+	vec3.push_back('x');
+	EXPECT_EQ(vec3.capacity(), 8192u);
+
+	ccat::vector<int, std::allocator<int>, ccat::growth_policy::size_class_rounded> vec4(33);
+	EXPECT_EQ(vec4.capacity(), 40u); // 132 bytes live in the 160-byte class
+	vec4.resize(41);
+	EXPECT_EQ(vec4.capacity(), 64u); // 1.5x is 240 bytes, rounded up to the 256-byte class
+}
+
+TEST_F(test_vector, allocate_at_least) {
+	ccat::vector<int, generous_allocator<int>> vec;
+	vec.push_back(1);
+	EXPECT_EQ(vec.capacity(), 8u);
+	for (int i = 2; i <= 8; ++i) vec.push_back(i);
+	EXPECT_EQ(vec.capacity(), 8u);
+	vec.push_back(9);
+	EXPECT_EQ(vec.capacity(), 19u);
+	vec.reserve(100);
+	EXPECT_EQ(vec.capacity(), 107u);
+	EXPECT_TRUE(std::ranges::equal(vec, std::views::iota(1, 10)));
+}
+
+TEST_F(test_vector, arena_allocator) {
+	using vector_type = ccat::vector<int, ccat::arena_allocator<int>>;
+	static_assert(ccat::concepts::reallocatable_into<int, vector_type>);
+	ccat::monotonic_arena arena, other_arena;
+
+	vector_type vec(arena);
+	vec.push_back(0);
+	auto* first = vec.data();
+	for (int i = 1; i < 100; ++i) {
+		vec.push_back(i);
+	}
+	EXPECT_EQ(vec.data(), first); // the last allocation grows in place
+	EXPECT_TRUE(std::ranges::equal(vec, std::views::iota(0, 100)));
+
+	vector_type copy = vec;
+	EXPECT_EQ(copy.get_allocator().arena(), &arena);
+	vector_type elsewhere({1, 2, 3}, other_arena);
+	elsewhere = vec; // allocators never propagate, the elements are copied into `other_arena`
+	EXPECT_EQ(elsewhere.get_allocator().arena(), &other_arena);
+	EXPECT_EQ(elsewhere, vec);
+	elsewhere = std::move(copy);
+	EXPECT_EQ(elsewhere.get_allocator().arena(), &other_arena);
+	EXPECT_EQ(elsewhere.size(), 100u);
+	elsewhere.assign({7, 8});
+	EXPECT_EQ(elsewhere.get_allocator().arena(), &other_arena);
+	EXPECT_EQ(elsewhere, (vector_type({7, 8}, arena)));
+
+	vector_type moved = std::move(vec); // a move takes the allocator along
+	EXPECT_EQ(moved.get_allocator().arena(), &arena);
+	EXPECT_EQ(moved.data(), first);
+}
+
+#if defined(__linux__)
+TEST_F(test_vector, mmap_allocator) {
+	using vector_type = ccat::vector<std::size_t, ccat::mmap_allocator<std::size_t, 4096>>;
+	static_assert(ccat::concepts::reallocatable_into<std::size_t, vector_type>);
+	static_assert(!ccat::concepts::reallocatable_into<std::string, ccat::vector<std::string, ccat::mmap_allocator<std::string>>>);
+
+	vector_type vec;
+	for (std::size_t i = 0; i < 1000000; ++i) {
+		vec.push_back(i);
+	}
+	EXPECT_EQ(vec.size(), 1000000u);
+	EXPECT_EQ(vec.capacity() * sizeof(std::size_t) % 4096, 0u);
+	EXPECT_TRUE(std::ranges::equal(vec, std::views::iota(std::size_t{0}, std::size_t{1000000})));
+
+	vec.resize(vec.capacity());
+	vec.push_back(vec[42]); // the argument lives in the buffer being remapped
+	EXPECT_EQ(vec.back(), 42u);
+	vec.erase(vec.begin() + 10, vec.end());
+	vec.shrink_to_fit(); // back to `std::allocator`
+	EXPECT_TRUE(std::ranges::equal(vec, std::views::iota(std::size_t{0}, std::size_t{10})));
+
+	ccat::vector<relocatable_handle, ccat::mmap_allocator<relocatable_handle, 4096>> handles;
+	for (int i = 0; i < 10000; ++i) {
+		handles.emplace_back(i);
+	}
+	EXPECT_EQ(*handles[9999].ptr, 9999);
+}
+#endif
+
 auto main(int argc, char* argv[]) ->int {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();